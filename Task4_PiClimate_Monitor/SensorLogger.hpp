@@ -0,0 +1,72 @@
+#pragma once
+// Reading type and file logger for the DHT11 app, kept free of pigpio so
+// other programs (such as Task5's hotpath_budget harness) can use them.
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+
+struct SensorReading
+{
+    /* data */
+    float Temperature;
+    float humidity;
+};
+
+// Appends one line per reading. The file is opened once and each log() is a
+// single write() of a line formatted into a member buffer: no reopen, no
+// heap allocation, no stdio flush on the sampling path.
+class SensorLogger
+{
+
+private:
+    SensorReading reading;
+    std::string filename;
+    int fd;
+    char timeBuffer[64];
+    char logBuffer[128];
+
+public:
+    SensorLogger(std::string name) : filename{name}
+    {
+        fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            std::cerr << "Error: Can't open " << filename << std::endl;
+        }
+    }
+    ~SensorLogger(){
+        if (fd >= 0) close(fd);
+    };
+    SensorLogger(const SensorLogger&) = delete;
+    SensorLogger& operator=(const SensorLogger&) = delete;
+
+    void log(SensorReading Reading) 
+    {
+        reading = Reading;
+        get_currentTime();
+        int length = snprintf(logBuffer, sizeof(logBuffer), "[%s] Temp: %.1f°C, Humidity: %.1f%%\n", timeBuffer, reading.Temperature, reading.humidity);
+        if (length <= 0) return;
+        if (static_cast<size_t>(length) >= sizeof(logBuffer)) length = sizeof(logBuffer) - 1;
+        writeLine(logBuffer, static_cast<size_t>(length));
+    }
+
+    int writeLine(const char *line, size_t length)
+    {
+        if (fd < 0)
+        {
+            return -1;
+        }
+        return write(fd, line, length);
+    }
+    void get_currentTime()
+    {
+        // localtime_r: no tzset() (and no stat of /etc/localtime) per call
+        std::time_t now = std::time(nullptr);
+        std::tm tm;
+        localtime_r(&now, &tm);
+        std::strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d %H:%M:%S", &tm);
+    }
+};
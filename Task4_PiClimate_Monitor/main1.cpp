@@ -11,6 +11,126 @@
 #include <fcntl.h>
 #include <ctime>
 #include <unistd.h>
+#include <optional>
+#include <string>
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <alloca.h>
+#include "SensorLogger.hpp"
+// Delay source for the sensor code, so the warm-up and retry waits can be
+// replaced without touching the DHT11 logic. PigpioClock is the real one.
+class Clock
+{
+public:
+    virtual ~Clock() = default;
+    virtual void DelayMicros(uint32_t micros) = 0;
+};
+
+class PigpioClock : public Clock
+{
+public:
+    void DelayMicros(uint32_t micros) override
+    {
+        gpioDelay(micros);
+    }
+};
+
+// Opt-in real-time mode for the DHT11 bit decoding: SCHED_FIFO priority,
+// CPU affinity and a pre-faulted stack while the scope is alive. The
+// destructor restores the previous policy and affinity. Steps that fail
+// (EPERM without root) are skipped with a warning, so the read still runs.
+//
+// This mirrors MCAL::RealTimeScope in the Task5 library (realtime.hpp).
+// Task4 is built as a single file against pigpio and does not link that
+// library, so the copy is kept here; change both together. Unlike the
+// Task5 scope, memory locking is not per scope: LockProcessMemory() locks
+// once for the life of the process, so short scopes around each read do
+// not pay for mlockall/munlockall every time.
+struct RealTimeConfig
+{
+    int priority = 80;
+    int cpu = 3;                      // last core on the Pi 3, -1 = keep affinity
+    size_t prefaultStack = 64 * 1024;
+};
+
+// mlockall(MCL_CURRENT | MCL_FUTURE) for the rest of the process; false (with
+// a warning) if it is not permitted
+inline bool LockProcessMemory()
+{
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+    {
+        return true;
+    }
+    std::cerr << "Warning: mlockall failed - " << strerror(errno) << "\n";
+    return false;
+}
+
+class RealTimeScope
+{
+private:
+    int previousPolicy;
+    sched_param previousParam;
+    cpu_set_t previousAffinity;
+    bool schedulingApplied = false;
+    bool affinityApplied = false;
+
+    __attribute__((noinline)) static void prefaultStack(size_t bytes)
+    {
+        auto *stack = static_cast<unsigned char *>(alloca(bytes));
+        memset(stack, 0, bytes);
+        asm volatile("" : : "r"(stack) : "memory");
+    }
+
+public:
+    explicit RealTimeScope(const RealTimeConfig &config)
+    {
+        pthread_t self = pthread_self();
+        pthread_getschedparam(self, &previousPolicy, &previousParam);
+        CPU_ZERO(&previousAffinity);
+        pthread_getaffinity_np(self, sizeof(previousAffinity), &previousAffinity);
+
+        if (config.prefaultStack > 0)
+        {
+            prefaultStack(config.prefaultStack);
+        }
+        if (config.cpu >= 0)
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(config.cpu, &cpus);
+            affinityApplied = (pthread_setaffinity_np(self, sizeof(cpus), &cpus) == 0);
+            if (!affinityApplied)
+            {
+                std::cerr << "Warning: can't pin to CPU " << config.cpu << "\n";
+            }
+        }
+        sched_param param{};
+        param.sched_priority = config.priority;
+        schedulingApplied = (pthread_setschedparam(self, SCHED_FIFO, &param) == 0);
+        if (!schedulingApplied)
+        {
+            std::cerr << "Warning: SCHED_FIFO unavailable (run as root)\n";
+        }
+    }
+    RealTimeScope(const RealTimeScope &) = delete;
+    RealTimeScope &operator=(const RealTimeScope &) = delete;
+
+    ~RealTimeScope()
+    {
+        pthread_t self = pthread_self();
+        if (schedulingApplied)
+        {
+            pthread_setschedparam(self, previousPolicy, &previousParam);
+        }
+        if (affinityApplied)
+        {
+            pthread_setaffinity_np(self, sizeof(previousAffinity), &previousAffinity);
+        }
+    }
+};
+
 enum class SensorStatus
 {
     Ok,
@@ -19,12 +139,24 @@ enum class SensorStatus
     NotConnected
 };
 
-struct SensorReading
+// Read success counters plus the wake-up latency of the 18 ms start-signal
+// delay (how late the thread got the CPU back), to compare normal and
+// real-time runs.
+struct ReadStats
 {
-    /* data */
-    float Temperature;
-    float humidity;
+    uint32_t attempts = 0;
+    uint32_t successes = 0;
+    uint32_t checksumErrors = 0;
+    uint32_t timingErrors = 0;
+    uint32_t wakeupLateMaxMicros = 0;
+    uint64_t wakeupLateSumMicros = 0;
+
+    uint32_t AvgWakeupLateMicros() const
+    {
+        return attempts == 0 ? 0 : static_cast<uint32_t>(wakeupLateSumMicros / attempts);
+    }
 };
+
 enum class PinDirection
 {
     Input,
@@ -160,92 +292,52 @@ class DHT11 : public Sensor
 private:
     std::array<uint8_t, 5> buffer;
     std::unique_ptr<GPIO> _gpio;
+    Clock &_clock;
+    std::optional<RealTimeConfig> _realTime;
+    ReadStats _stats;
     static constexpr int MAX_RETRIES = 5;
 
 public:
     DHT11() = delete;
     // Prevent accidental conversions
-    explicit DHT11(PinNumber pin) : _gpio{std::make_unique<GPIO>(pin)}, buffer{}
+    explicit DHT11(PinNumber pin, Clock &clock) : buffer{}, _gpio{std::make_unique<GPIO>(pin)}, _clock{clock}
     {
         std::cout << "Waiting 2 seconds for sensor warm-up...\n";
-        gpioDelay(2000000); // 2 seconds = 2,000,000 microseconds
+        _clock.DelayMicros(2000000); // 2 seconds = 2,000,000 microseconds
+    }
+    // Run the timing-critical part of every attempt (start signal through
+    // the last bit) under a RealTimeScope with this config
+    void EnableRealTime(const RealTimeConfig &config)
+    {
+        _realTime = config;
+    }
+    void DisableRealTime()
+    {
+        _realTime.reset();
+    }
+    const ReadStats &Stats() const
+    {
+        return _stats;
     }
+
     // override tells the compiler: "I intend to override a virtual function from the base class."
     std::pair<SensorStatus, SensorReading> ReadSensorData() override
     {
-
         for (int attempt = 1; attempt <= MAX_RETRIES; attempt++)
         {
             std::cout << "Attempt " << attempt << " of " << MAX_RETRIES << "...\n";
 
-            bool attemptFailed = false;
-
-            // step1; pi to sensor => start signal
-            _gpio->SetDir(PinDirection::Output);
-            _gpio->SetValue(PinValue::Low);
-            gpioDelay(18000); // wait 18msec
-            _gpio->SetValue(PinValue::High);
-            gpioDelay(30); // wait 30 usec
+            _stats.attempts++;
 
-            // step2: sensor to pi => ack signal
-            _gpio->SetDir(PinDirection::Input);
-
-            // wait for low 80 usec
-            if (waitForPin(PinValue::Low, 200) != SensorStatus::Ok)
+            // Only the bit timing runs real-time; the retry sleep below does not
+            bool attemptFailed;
             {
-                std::cout << "Error Receving Low ack form sensor\n";
-                attemptFailed = true;
-            }
-            if (!attemptFailed && waitForPin(PinValue::High, 200) != SensorStatus::Ok)
-            {
-                std::cout << "Error Receving High ack form sensor\n";
-                attemptFailed = true;
-            }
-
-            // fill buffer with zerooooooooooos
-            buffer.fill(0);
-            // step3: get sensor values
-
-            if (!attemptFailed)
-            {
-                for (int i = 0; i < 40; i++)
+                std::optional<RealTimeScope> realTime;
+                if (_realTime)
                 {
-                    int byteIndex = i / 8;      // Which byte?
-                    int bitIndex = 7 - (i % 8); // Which bit in that byte?
-
-                    // Wait for LOW marker to end
-                    if (waitForPin(PinValue::Low, 200) != SensorStatus::Ok)
-                    {
-                        std::cout << "Error: Receving Low marker at bit " << i << "\n";
-                        attemptFailed = true;
-                        break;
-                    }
-                    // Wait for HIGH to start
-                    if (waitForPin(PinValue::High, 200) != SensorStatus::Ok)
-                    {
-                        std::cout << "Error: Receving High marker at bit " << i << "\n";
-                        attemptFailed = true;
-                        break;
-                    }
-
-                    // Measure HIGH duration
-                    // If duration > 40μs → bit is 1
-                    // Store bit in buffer
-
-                    int duration = MeasureHighDuration();
-                    if (duration == -1)
-                    {
-                        // FIX: Don't throw, set flag and break
-                        std::cout << "Error: high duraiton timeout at bit " << i << "\n";
-                        attemptFailed = true;
-                        break;
-                    }
-                    else if (duration > 40)
-                    {
-                        // To set a bit:
-                        buffer[byteIndex] |= (1 << bitIndex);
-                    }
+                    realTime.emplace(*_realTime);
                 }
+                attemptFailed = !ReadFrame();
             }
 
             // Check if read succeeded and validate checksum
@@ -254,6 +346,7 @@ public:
                 // step4: Validate checksum
                 if (checkSum() == SensorStatus::Ok)
                 {
+                    _stats.successes++;
                     // Success! Return the reading
                     SensorReading reading;
                     reading.Temperature = extractTemperature();
@@ -262,20 +355,112 @@ public:
                 }
                 else
                 {
+                    _stats.checksumErrors++;
                     std::cout << "Checksum error\n";
                 }
             }
+            else
+            {
+                _stats.timingErrors++;
+            }
 
             // Wait 2 seconds before next attempt
             if (attempt < MAX_RETRIES)
             {
                 std::cout << "Retrying in 2 seconds...\n";
-                gpioDelay(2000000);
+                _clock.DelayMicros(2000000);
             }
         }
 
         return {SensorStatus::Timeout, {}};
     }
+    // Start signal, acknowledge and 40 data bits into buffer; false on a
+    // timing error (the reason has been printed)
+    bool ReadFrame()
+    {
+        bool attemptFailed = false;
+
+        // step1; pi to sensor => start signal
+        _gpio->SetDir(PinDirection::Output);
+        _gpio->SetValue(PinValue::Low);
+        uint32_t delayStart = gpioTick();
+        gpioDelay(18000); // wait 18msec
+        uint32_t late = (gpioTick() - delayStart) - 18000;
+        if (static_cast<int32_t>(late) > 0)
+        {
+            _stats.wakeupLateSumMicros += late;
+            if (late > _stats.wakeupLateMaxMicros)
+            {
+                _stats.wakeupLateMaxMicros = late;
+            }
+        }
+        _gpio->SetValue(PinValue::High);
+        gpioDelay(30); // wait 30 usec
+
+        // step2: sensor to pi => ack signal
+        _gpio->SetDir(PinDirection::Input);
+
+        // wait for low 80 usec
+        if (waitForPin(PinValue::Low, 200) != SensorStatus::Ok)
+        {
+            std::cout << "Error Receving Low ack form sensor\n";
+            attemptFailed = true;
+        }
+        if (!attemptFailed && waitForPin(PinValue::High, 200) != SensorStatus::Ok)
+        {
+            std::cout << "Error Receving High ack form sensor\n";
+            attemptFailed = true;
+        }
+
+        // fill buffer with zerooooooooooos
+        buffer.fill(0);
+        // step3: get sensor values
+
+        if (!attemptFailed)
+        {
+            for (int i = 0; i < 40; i++)
+            {
+                int byteIndex = i / 8;      // Which byte?
+                int bitIndex = 7 - (i % 8); // Which bit in that byte?
+
+                // Wait for LOW marker to end
+                if (waitForPin(PinValue::Low, 200) != SensorStatus::Ok)
+                {
+                    std::cout << "Error: Receving Low marker at bit " << i << "\n";
+                    attemptFailed = true;
+                    break;
+                }
+                // Wait for HIGH to start
+                if (waitForPin(PinValue::High, 200) != SensorStatus::Ok)
+                {
+                    std::cout << "Error: Receving High marker at bit " << i << "\n";
+                    attemptFailed = true;
+                    break;
+                }
+
+                // Measure HIGH duration
+                // If duration > 40μs → bit is 1
+                // Store bit in buffer
+
+                int duration = MeasureHighDuration();
+                if (duration == -1)
+                {
+                    // FIX: Don't throw, set flag and break
+                    std::cout << "Error: high duraiton timeout at bit " << i << "\n";
+                    attemptFailed = true;
+                    break;
+                }
+                else if (duration > 40)
+                {
+                    // To set a bit:
+                    buffer[byteIndex] |= (1 << bitIndex);
+                }
+            }
+        }
+
+        return !attemptFailed;
+    }
+
     SensorStatus checkSum() const
     {
         uint32_t sum = 0;
@@ -338,64 +523,24 @@ public:
     }
 };
 
-class SensorLogger
-{
-
-private:
-    SensorReading reading;
-    std::string filename;
-    int fd;
-    char timeBuffer[64];
-    char logBuffer[128];
-
-public:
-    SensorLogger(std::string name) : filename{name}
-    {
-    }
-    ~SensorLogger(){
-    };
-    SensorLogger(const SensorLogger&) = delete;
-    SensorLogger& operator=(const SensorLogger&) = delete;
-
-    void log(SensorReading Reading) 
-    {
-         reading = Reading;
-        get_currentTime();
-        sprintf(logBuffer, "[%s] Temp: %.1f°C, Humidity: %.1f%%\n",timeBuffer, reading.Temperature, reading.humidity);
-        writeToFile(filename,logBuffer);
-        close(fd);
-
-    }
-
-    int writeToFile(const std::string &path, const std::string &value)
-    {
-        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);   
-        if (fd < 0)
-        {
-            std::cerr << "Error: Can't open " << path << std::endl;
-            return -1;
-        }
-        auto numBytes = write(fd, value.c_str(), value.length());
-       
-        return numBytes;
-    }
-    void get_currentTime()
-    {
-        std::time_t now = std::time(nullptr);
-        std::tm *tm = std::localtime(&now);
-        std::strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d %H:%M:%S", tm);
-    }
-};
-
 uint32_t GPIO::InstanceCounter = 0;
 
 
-int main()
+int main(int argc, char *argv[])
 {
     try
     {
-        DHT11 sensor(PinNumber::GPIO_PIN_4);
+        PigpioClock clock;
+        DHT11 sensor(PinNumber::GPIO_PIN_4, clock);
         SensorLogger logger("sensor_log.txt"); 
+
+        // ./app --rt : decode the sensor bits under SCHED_FIFO on a pinned core
+        if (argc > 1 && std::string(argv[1]) == "--rt")
+        {
+            std::cout << "Real-time mode enabled\n";
+            LockProcessMemory();
+            sensor.EnableRealTime(RealTimeConfig{});
+        }
         
         while (true)
         {
@@ -408,8 +553,14 @@ int main()
                 
                 logger.log(reading); 
             }
+
+            const ReadStats &stats = sensor.Stats();
+            std::cout << "Success " << stats.successes << "/" << stats.attempts
+                      << " (checksum " << stats.checksumErrors << ", timing " << stats.timingErrors << ")"
+                      << " | wake-up late avg " << stats.AvgWakeupLateMicros() << "us"
+                      << " max " << stats.wakeupLateMaxMicros << "us\n";
             
-            gpioDelay(2000000);
+            clock.DelayMicros(2000000);
         }
     }
     catch (const std::exception &e)
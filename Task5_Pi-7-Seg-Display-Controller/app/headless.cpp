@@ -0,0 +1,332 @@
+#include "headless.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include "BroadcastOStream.hpp"
+#include "DigitPipeline.hpp"
+#include "SevenSegment.hpp"
+#include "TerminalDisplay.hpp"
+#include "Ticker.hpp"
+#include "clock.hpp"
+#include "gpio_sim.hpp"
+#include "perf_counters.hpp"
+#include "terminal.hpp"
+
+using namespace HardwareIO;
+
+namespace {
+
+    // Digits 0..9 repeating, each stamped when it enters the pipeline. The
+    // stamps live in a ring indexed by sequence number; the pipeline blocks
+    // on a full queue, so fewer than RingSize digits are ever in flight.
+    //
+    // With a rate, digit n is due at start + n / rate and is stamped with
+    // that due time rather than the time it was actually produced, so a
+    // writer that falls behind shows up in the latency instead of silently
+    // slowing the input down.
+    class GeneratedDigits final : public IStream {
+        public:
+            static constexpr std::size_t RingSize = 4096;
+
+        private:
+            MCAL::Clock & clock = MCAL::ActiveClock();
+            unsigned long long limit;
+            std::chrono::nanoseconds deadline{0};
+            std::chrono::nanoseconds period{0};
+            std::chrono::nanoseconds start{0};
+            unsigned long long sent = 0;
+            std::vector<long long> sentAt = std::vector<long long>(RingSize);
+
+        public:
+            GeneratedDigits(unsigned long long count, std::chrono::milliseconds duration, unsigned long long rate)
+                : limit(duration.count() > 0 ? ~0ULL : count)
+            {
+                start = clock.Now();
+                if (duration.count() > 0) deadline = start + duration;
+                if (rate > 0) period = std::chrono::nanoseconds(1000000000ULL / rate);
+            }
+
+            DigitResult tryReadDigit() noexcept override {
+                auto now = clock.Now();
+                if (sent >= limit || (deadline.count() > 0 && now >= deadline)) return {0, InputError::EndOfInput};
+                if (period.count() > 0) {
+                    auto due = start + period * static_cast<long long>(sent);
+                    if (due > now) clock.SleepPrecise(due - now);
+                    now = due;
+                }
+                sentAt[sent % RingSize] = now.count();
+                return {static_cast<int>(sent++ % 10), InputError::None};
+            }
+
+            long long sentTime(unsigned long long sequence) const { return sentAt[sequence % RingSize]; }
+    };
+
+    // The art device: a 4-digit display redrawn at up to 60 frames per second
+    constexpr std::size_t ArtDigits = 4;
+    constexpr unsigned ArtFps = 60;
+    constexpr unsigned DefaultTickerFps = 10;
+
+    static_assert(GeneratedDigits::RingSize > PipelineConfig{}.QueueCapacity + 2, "ring covers every digit in flight");
+
+    unsigned long long parseCount(const std::string & flag, const char * value) {
+        try {
+            long long count = std::stoll(value);
+            if (count > 0) return static_cast<unsigned long long>(count);
+        }
+        catch (const std::exception&) {}
+        throw std::invalid_argument(flag + " needs a positive number");
+    }
+
+    Backpressure parsePolicy(const std::string & value) {
+        if (value == "drop-oldest") return Backpressure::DropOldest;
+        if (value == "drop-newest") return Backpressure::DropNewest;
+        if (value == "block") return Backpressure::Block;
+        throw std::invalid_argument("--sink-policy must be drop-oldest, drop-newest or block");
+    }
+
+    double cpuSeconds(const struct timeval & time) {
+        return time.tv_sec + time.tv_usec / 1e6;
+    }
+
+    double percentileUs(std::vector<long long> & samples, double fraction) {
+        if (samples.empty()) return 0;
+        std::size_t index = std::min(samples.size() - 1, static_cast<std::size_t>(fraction * samples.size()));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return samples[index] / 1000.0;
+    }
+
+    int runTicker(const HeadlessOptions & options) {
+        std::ofstream devNull("/dev/null");
+        TerminalDisplay display(ArtDigits, ArtFps, devNull);
+        Ticker ticker(ArtDigits);
+        ticker.load(options.Ticker.c_str());
+
+        unsigned fps = DefaultTickerFps;
+        if (options.Rate > 0) fps = static_cast<unsigned>(std::min<unsigned long long>(options.Rate, 1000000));
+        TickerPlayer player(fps);
+        player.add(ticker, display);
+        std::chrono::nanoseconds length = options.Duration;
+        if (length.count() == 0) length = std::chrono::nanoseconds(1000000000LL / fps) * static_cast<long long>(ticker.frameCount());
+
+        MCAL::Clock & clock = MCAL::ActiveClock();
+        struct rusage before, after;
+        getrusage(RUSAGE_SELF, &before);
+        auto start = clock.Now();
+        display.start();
+        player.start();
+        std::this_thread::sleep_for(length);
+        player.stop();
+        display.stop();
+        double seconds = std::chrono::duration<double>(clock.Now() - start).count();
+        getrusage(RUSAGE_SELF, &after);
+        double cpu = cpuSeconds(after.ru_utime) - cpuSeconds(before.ru_utime) + cpuSeconds(after.ru_stime) - cpuSeconds(before.ru_stime);
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Ticker: \"" << options.Ticker << "\", " << ticker.frameCount() << " frames per pass, "
+                  << player.tickCount() << " ticks in " << seconds << " s (" << player.tickCount() / seconds
+                  << "/s of " << fps << "/s)\n"
+                  << "Art: " << display.frameCount() << " frames rendered, " << display.bytesPerUpdate()
+                  << " bytes per incremental frame\n"
+                  << "CPU: " << std::setprecision(3) << cpu << " s (" << std::setprecision(1)
+                  << 100 * cpu / seconds << "% of wall)" << std::endl;
+        return 0;
+    }
+
+}
+
+std::optional<HeadlessOptions> parseHeadless(int argc, char * argv[]) {
+    std::optional<HeadlessOptions> options;
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (flag == "--headless") {
+            if (!options) options.emplace();
+        }
+        else if (flag == "--device" || flag == "--backend" || flag == "--count" || flag == "--duration" || flag == "--rate" ||
+                 flag == "--sink-policy" || flag == "--ticker") {
+            if (!hasValue) throw std::invalid_argument(flag + " needs a value");
+            if (!options) options.emplace();
+            const char * value = argv[++i];
+            if (flag == "--device") options->Device = value;
+            else if (flag == "--backend") options->Backend = value;
+            else if (flag == "--count") options->Count = parseCount(flag, value);
+            else if (flag == "--rate") options->Rate = parseCount(flag, value);
+            else if (flag == "--sink-policy") options->SinkPolicy = parsePolicy(value);
+            else if (flag == "--ticker") options->Ticker = value;
+            else options->Duration = std::chrono::milliseconds(parseCount(flag, value) * 1000);
+        }
+    }
+
+    if (options) {
+        if (options->Device != "segment" && options->Device != "terminal" && options->Device != "broadcast" &&
+            options->Device != "art")
+            throw std::invalid_argument("--device must be segment, terminal, broadcast or art");
+        if (options->Backend != "sim" && options->Backend != "sysfs")
+            throw std::invalid_argument("--backend must be sim or sysfs");
+    }
+    return options;
+}
+
+int runHeadless(const HeadlessOptions & options) {
+    if (!options.Ticker.empty()) return runTicker(options);
+
+    std::unique_ptr<MCAL::GPIO::SysfsSimulator> simulator;
+    MCAL::VirtualClock setupClock;
+    if (options.Backend == "sim") {
+        simulator = std::make_unique<MCAL::GPIO::SysfsSimulator>();
+        // Simulated exports need no settle time
+        MCAL::SetActiveClock(&setupClock);
+    }
+
+    std::ofstream devNull("/dev/null");
+    FlushPolicy buffered;
+    buffered.Buffered = true;
+
+    // Export/unexport chatter is not part of the report
+    std::streambuf * console = std::cout.rdbuf(nullptr);
+    std::shared_ptr<SevenSegment> segment;
+    std::shared_ptr<Terminal> terminal;
+    if (options.Device == "segment" || options.Device == "broadcast") segment = std::make_shared<SevenSegment>();
+    if (options.Device == "terminal" || options.Device == "broadcast") terminal = std::make_shared<Terminal>(buffered, devNull);
+    bool pinsOpen = !segment || segment->pinsOpen();
+    std::cout.rdbuf(console);
+    MCAL::SetActiveClock(nullptr);
+
+    if (!pinsOpen) {
+        std::cerr << "Error: 7-segment pins are not usable on the " << options.Backend << " backend" << std::endl;
+        console = std::cout.rdbuf(nullptr);
+        segment.reset();
+        std::cout.rdbuf(console);
+        return 1;
+    }
+
+    // Built on the real clock: the sink workers and writeDigit must stamp
+    // with the same clock the latencies are measured against
+    std::shared_ptr<OStream> output;
+    std::shared_ptr<BroadcastOStream> broadcast;
+    std::shared_ptr<TerminalDisplay> art;
+    if (options.Device == "terminal") {
+        output = terminal;
+    }
+    else if (options.Device == "art") {
+        art = std::make_shared<TerminalDisplay>(ArtDigits, ArtFps, devNull);
+        art->start();
+        output = art;
+    }
+    else if (options.Device == "segment") {
+        output = segment;
+    }
+    else {
+        broadcast = std::make_shared<BroadcastOStream>();
+        broadcast->addSink(segment, SinkConfig{"7-segment", SinkConfig{}.QueueCapacity, options.SinkPolicy});
+        broadcast->addSink(terminal, SinkConfig{"terminal", SinkConfig{}.QueueCapacity, options.SinkPolicy});
+        output = broadcast;
+    }
+
+    GeneratedDigits input(options.Count, options.Duration, options.Rate);
+    DigitPipeline pipeline(input, *output);
+
+    std::vector<long long> latencies;
+    latencies.reserve(options.Duration.count() > 0 ? 1 << 20 : options.Count);
+    unsigned long long written = 0;
+    MCAL::Clock & clock = MCAL::ActiveClock();
+    pipeline.OnWritten = [&](int) {
+        latencies.push_back(clock.Now().count() - input.sentTime(written++));
+    };
+
+    // Opened before the pipeline starts its writer thread, so it is counted too
+    MCAL::PerfCounters counters;
+
+    struct rusage before, after;
+    getrusage(RUSAGE_SELF, &before);
+    auto start = clock.Now();
+    counters.Start();
+    pipeline.run();
+    MCAL::PerfReading perf = counters.Stop(written > 0 ? written : 1);
+    if (broadcast) broadcast->flush();
+    if (art) art->stop();
+    double seconds = std::chrono::duration<double>(clock.Now() - start).count();
+    getrusage(RUSAGE_SELF, &after);
+
+    double user = cpuSeconds(after.ru_utime) - cpuSeconds(before.ru_utime);
+    double system = cpuSeconds(after.ru_stime) - cpuSeconds(before.ru_stime);
+    PipelineStats stats = pipeline.stats();
+
+    // A broadcast only counts what reached every sink; dropped digits were never shown
+    unsigned long long delivered = written;
+    unsigned long long dropped = 0;
+    unsigned long long failed = 0;
+    if (broadcast) {
+        for (std::size_t i = 0; i < broadcast->sinkCount(); i++) {
+            SinkStats sink = broadcast->stats(i);
+            delivered = std::min(delivered, sink.Written);
+            dropped = std::max(dropped, sink.Queue.Dropped);
+            failed += sink.Errors;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Device: " << options.Device << " (" << options.Backend << "), "
+              << delivered << " digits in " << seconds << " s";
+    if (options.Rate > 0) std::cout << ", paced at " << options.Rate << "/s";
+    std::cout << "\n"
+              << "Throughput: " << std::setprecision(0) << (seconds > 0 ? delivered / seconds : 0) << " digits/s";
+    if (broadcast) std::cout << " written by every sink (up to " << dropped << " dropped by a sink)";
+    std::cout << "\n"
+              << std::setprecision(1)
+              << "Latency (" << (options.Rate > 0 ? "due" : "read") << " -> written"
+              << (broadcast ? " to the sink queues" : "") << "): p50 "
+              << percentileUs(latencies, 0.50) << " us, p99 " << percentileUs(latencies, 0.99)
+              << " us, p999 " << percentileUs(latencies, 0.999) << " us";
+    if (options.Rate == 0) std::cout << " (unpaced: mostly queueing, see --rate)";
+    std::cout << "\n"
+              << "Service time (writeDigit): avg " << stats.Write.Avg.count() / 1000.0
+              << " us, max " << stats.Write.Max.count() / 1000.0 << " us; queue wait avg "
+              << stats.QueueWait.Avg.count() / 1000.0 << " us\n"
+              << std::setprecision(3)
+              << "CPU: user " << user << " s, system " << system << " s ("
+              << std::setprecision(0) << (seconds > 0 ? 100 * (user + system) / seconds : 0) << "% of wall)\n"
+              << "Queue high water: " << stats.Queue.HighWater << "/" << stats.Queue.Capacity << "\n"
+              << "Counters: ";
+    std::cout << perf;
+    if (!counters.HardwareAvailable()) std::cout << " (hardware counters unavailable)";
+    else if (!counters.KernelIncluded()) std::cout << " (user space only)";
+    std::cout << "\n";
+    if (art) {
+        // writeDigit only publishes; the renderer draws what is newest at up to ArtFps
+        std::cout << "Art: " << art->frameCount() << " frames rendered ("
+                  << std::setprecision(1) << (seconds > 0 ? art->frameCount() / seconds : 0) << " fps), "
+                  << art->bytesPerUpdate() << " bytes per incremental frame, " << std::setprecision(0)
+                  << (seconds > 0 ? art->byteCount() / seconds : 0) << " bytes/s\n";
+    }
+    if (broadcast) {
+        for (std::size_t i = 0; i < broadcast->sinkCount(); i++) {
+            SinkStats sink = broadcast->stats(i);
+            std::cout << "Sink " << sink.Name << ": written " << sink.Written << ", dropped " << sink.Queue.Dropped
+                      << ", errors " << sink.Errors << ", max latency " << sink.MaxLatency.count() / 1000 << " us\n";
+        }
+    }
+    std::cout << std::flush;
+    if (dropped > 0) {
+        std::cerr << "Warning: a sink dropped " << dropped << " of " << written
+                  << " digits; the throughput above only counts digits every sink wrote"
+                  << " (--sink-policy block writes them all)" << std::endl;
+    }
+    if (failed > 0) std::cerr << "Warning: " << failed << " sink writes failed" << std::endl;
+
+    // Quiet teardown, like the setup
+    console = std::cout.rdbuf(nullptr);
+    output.reset();
+    broadcast.reset();
+    art.reset();
+    segment.reset();
+    terminal.reset();
+    std::cout.rdbuf(console);
+    return 0;
+}
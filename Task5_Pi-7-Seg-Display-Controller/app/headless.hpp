@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+#include <optional>
+#include <string>
+#include "SpscQueue.hpp"
+
+// Non-interactive end-to-end run: generated digits go through the same
+// DigitPipeline as the interactive app into the chosen device, and the
+// throughput, latency percentiles and CPU time are reported.
+//
+//   SevenSegmentProject --headless [--device segment|terminal|broadcast|art]
+//                       [--backend sim|sysfs] [--count N | --duration SECONDS]
+//                       [--rate DIGITS_PER_SECOND]
+//                       [--sink-policy drop-oldest|drop-newest|block]
+//   SevenSegmentProject --ticker TEXT [--rate FRAMES_PER_SECOND] [--duration SECONDS]
+//
+// The sim backend (the default) needs no hardware or root, so the numbers
+// can be tracked on any Linux machine. Without --rate the input runs flat
+// out, which measures peak throughput; latency is only meaningful when the
+// input is paced below that. The art device is a 4-digit TerminalDisplay
+// writing to /dev/null, and reports the bytes of each incremental redraw.
+// --sink-policy sets the broadcast sinks' queue policy: the app's
+// drop-oldest by default, block to write every digit.
+//
+// --ticker plays TEXT scrolling across the art device with a TickerPlayer
+// instead of running the pipeline, at --rate frames per second (10 by
+// default) for --duration or one pass of the message, and reports the
+// ticks and art frames it managed.
+struct HeadlessOptions {
+    std::string Device = "segment";
+    std::string Backend = "sim";
+    unsigned long long Count = 100000;
+    std::chrono::milliseconds Duration{0};      // non-zero: run this long instead of Count digits
+    unsigned long long Rate = 0;                // digits per second; 0 runs unpaced
+    HardwareIO::Backpressure SinkPolicy = HardwareIO::Backpressure::DropOldest;   // broadcast sinks
+    std::string Ticker;                         // non-empty: play this on the art device instead
+};
+
+// Empty unless a headless flag is present; throws std::invalid_argument on a bad value
+std::optional<HeadlessOptions> parseHeadless(int argc, char * argv[]);
+
+// Returns the process exit code
+int runHeadless(const HeadlessOptions & options);
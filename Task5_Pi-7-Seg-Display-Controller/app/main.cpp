@@ -1,12 +1,48 @@
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include "SevenSegment.hpp"
 #include "terminal.hpp"
+#include "TerminalDisplay.hpp"
+#include "DigitPipeline.hpp"
+#include "BroadcastOStream.hpp"
+#include "gpio_trace.hpp"
+#include "KeystrokeReader.hpp"
+#include "headless.hpp"
 
+static const char * const LogPath = "digits.log";
 
-int main() {
+
+int main(int argc, char * argv[]) {
     using namespace HardwareIO;
 
+    // --trace <file>: record every GPIO operation for gpio_replay. Declared
+    // before the devices so their unexports are recorded too.
+    std::unique_ptr<MCAL::GPIO::TraceRecorder> trace;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::string(argv[i]) == "--trace") {
+            try {
+                trace = std::make_unique<MCAL::GPIO::TraceRecorder>(argv[i + 1]);
+                MCAL::GPIO::GPIO_SetTraceRecorder(trace.get());
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Trace disabled: " << e.what() << std::endl;
+            }
+        }
+    }
+
+    // --headless (or any of its flags): benchmark run, no prompts
+    try {
+        if (auto headless = parseHeadless(argc, argv)) return runHeadless(*headless);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [--trace FILE] [--headless [--device segment|terminal|broadcast|art]"
+                  << " [--backend sim|sysfs] [--count N | --duration SECONDS] [--rate N]"
+                  << " [--sink-policy drop-oldest|drop-newest|block]] [--ticker TEXT [--rate N] [--duration SECONDS]]" << std::endl;
+        return 2;
+    }
+
     std::cout << "=== Raspberry Pi 7-Segment Controller ===" << std::endl;
     std::cout << std::endl;
     
@@ -16,7 +52,9 @@ int main() {
     std::cout << "Select output device:" << std::endl;
     std::cout << "1. Terminal" << std::endl;
     std::cout << "2. Seven Segment Display" << std::endl;
-    std::cout << "Enter choice (1 or 2): ";
+    std::cout << "3. Both, plus a log file (" << LogPath << ")" << std::endl;
+    std::cout << "4. Seven-segment art in the terminal" << std::endl;
+    std::cout << "Enter choice (1, 2, 3 or 4): ";
     
     int choice;
     std::cin >> choice;
@@ -24,8 +62,10 @@ int main() {
     // ============================================
     // 2. Use shared_ptr for Multiple References
     // ============================================
+    std::ofstream log;      // declared first so the log sink is gone before it closes
     std::shared_ptr<IStream> input;
     std::shared_ptr<OStream> output;
+    std::shared_ptr<TerminalDisplay> art;
     
     if (choice == 1) {
         auto device = std::make_shared<Terminal>();
@@ -39,6 +79,28 @@ int main() {
         output = device;
         std::cout << ">>> Using 7-Segment Display <<<" << std::endl;
     } 
+    else if (choice == 3) {
+        // Keyboard input from the terminal; every digit fans out to the
+        // display, a terminal mirror and the log, each at its own pace
+        auto terminal = std::make_shared<Terminal>();
+        auto broadcast = std::make_shared<BroadcastOStream>();
+        broadcast->addSink(std::make_shared<SevenSegment>(), SinkConfig{"7-segment"});
+        broadcast->addSink(terminal, SinkConfig{"terminal"});
+        log.open(LogPath, std::ios::app);
+        FlushPolicy logPolicy;
+        logPolicy.Buffered = true;
+        broadcast->addSink(std::make_shared<Terminal>(logPolicy, log), SinkConfig{"log"});
+        input = terminal;
+        output = broadcast;
+        std::cout << ">>> Broadcasting to 7-Segment, Terminal and Log <<<" << std::endl;
+    }
+    else if (choice == 4) {
+        // Four digits scrolling in from the right, redrawn in place
+        input = std::make_shared<Terminal>();
+        art = std::make_shared<TerminalDisplay>(4);
+        output = art;
+        std::cout << ">>> Using Terminal Seven-Segment Art <<<" << std::endl;
+    }
     else {
         std::cerr << "Invalid choice! Defaulting to Terminal." << std::endl;
         auto device = std::make_shared<Terminal>();
@@ -46,37 +108,81 @@ int main() {
         output = device;
     }
     
+    // At a terminal each key goes straight to the pipeline: no Enter and no
+    // per-digit prompt, so keypress-to-display is just the queue hop and write
+    std::shared_ptr<KeystrokeReader> keys;
+    if (isatty(STDIN_FILENO)) {
+        keys = std::make_shared<KeystrokeReader>();
+        if (keys->isRaw()) {
+            input = keys;
+            std::cout << "Type digits, 'q' to quit." << std::endl;
+        } else {
+            keys.reset();
+        }
+    }
+
     std::cout << std::endl;
 
     // ============================================
-    // 3. Main Loop
+    // 3. Pipelined Main Loop
     // ============================================
-    bool running = true;
-    
-    while (running) {
-        try {
-            int digit = input->readDigit();
-            output->writeDigit(digit);
-            
-            std::cout << "Digit " << digit << " displayed successfully." << std::endl;
-        } 
-        catch (const std::invalid_argument& e) {
-            std::cerr << "Input Error: " << e.what() << std::endl;
-        }
-        catch (const std::exception& e) {
-            std::cerr << "Unexpected error: " << e.what() << std::endl;
-        }
+    // Reading and displaying run on separate threads joined by a bounded
+    // queue, so neither side waits for the other
+    DigitPipeline pipeline(*input, *output);
+
+    // No flush per digit: stdout is line buffered at a terminal, and cin is
+    // tied to cout, so the prompt still appears before each read
+    // The art is redrawn over the 3 lines above the cursor, so nothing else
+    // may print while it runs
+    if (!art) {
+        pipeline.OnWritten = [](int digit) {
+            std::cout << "Digit " << digit << " displayed successfully.\n";
+        };
+    }
+    pipeline.OnWriteError = [](const std::exception& e) {
+        std::cerr << "Unexpected error: " << e.what() << std::endl;
+    };
+    pipeline.OnInputError = [](InputError error) {
+        std::cerr << "Input Error: " << describe(error) << std::endl;
+    };
+    if (!keys && !art) {
+        pipeline.KeepReading = []() {
+            std::cout << '\n';
+            std::cout << "Press 'q' to quit or any other key to continue: ";
+            char ch;
+            return (std::cin >> ch) && ch != 'q' && ch != 'Q';
+        };
+    }
+
+    if (art) art->start();
+    pipeline.run();
+    if (art) {
+        // The renderer may stop before drawing the last digit
+        art->stop();
+        art->render();
+    }
+
+    PipelineStats stats = pipeline.stats();
+    std::cout << std::endl;
+    std::cout << "Queue: high water " << stats.Queue.HighWater << "/" << stats.Queue.Capacity
+              << ", dropped " << stats.Queue.Dropped << std::endl;
+    std::cout << "Read:  avg " << stats.Read.Avg.count() << " ns, max " << stats.Read.Max.count() << " ns" << std::endl;
+    std::cout << "Wait:  avg " << stats.QueueWait.Avg.count() << " ns, max " << stats.QueueWait.Max.count() << " ns" << std::endl;
+    std::cout << "Write: avg " << stats.Write.Avg.count() << " ns, max " << stats.Write.Max.count() << " ns" << std::endl;
+    if (art) {
+        std::cout << "Art: " << art->frameCount() << " frames, " << art->bytesPerUpdate()
+                  << " bytes per incremental frame, " << art->byteCount() << " bytes in all" << std::endl;
+    }
 
-        std::cout << std::endl;
-        std::cout << "Press 'q' to quit or any other key to continue: ";
-        char ch;
-        std::cin >> ch;
-        
-        if (ch == 'q' || ch == 'Q') {
-            running = false;
+    if (auto broadcast = std::dynamic_pointer_cast<BroadcastOStream>(output)) {
+        broadcast->flush();
+        for (std::size_t i = 0; i < broadcast->sinkCount(); i++) {
+            SinkStats sink = broadcast->stats(i);
+            std::cout << "Sink " << sink.Name << ": written " << sink.Written << ", dropped " << sink.Queue.Dropped
+                      << ", errors " << sink.Errors << ", lag " << sink.Lag << ", max latency " << sink.MaxLatency.count() << " ns" << std::endl;
         }
     }
 
     std::cout << "Goodbye!" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
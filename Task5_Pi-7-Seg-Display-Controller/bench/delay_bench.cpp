@@ -0,0 +1,80 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <ctime>
+#include <string>
+#include "precision_delay.hpp"
+#include "realtime.hpp"
+
+// Achieved delay error of PrecisionDelay vs std::this_thread::sleep_for for
+// targets from 1 us to 10 ms: p50/p99/max oversleep and CPU time per call.
+// Then the periodic wake-up latency of clock_nanosleep, with and without a
+// RealTimeScope, which is what the sleep half of PrecisionDelay is up against.
+
+using namespace std::chrono;
+using MCAL::PrecisionDelay;
+
+static nanoseconds threadCpuTime() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return seconds(ts.tv_sec) + nanoseconds(ts.tv_nsec);
+}
+
+static void reportWakeup(const char * name, const MCAL::WakeupLatency & latency) {
+    auto us = [](nanoseconds ns) { return ns.count() / 1000.0; };
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(14) << name << std::setw(10) << latency.Samples
+              << std::setw(12) << us(latency.Min) << std::setw(12) << us(latency.Avg)
+              << std::setw(12) << us(latency.P99) << std::setw(12) << us(latency.Max) << std::endl;
+}
+
+template <typename Delay>
+static void measure(const char * name, nanoseconds target, int samples, Delay delay) {
+    std::vector<long long> error(static_cast<std::size_t>(samples));
+    auto cpuStart = threadCpuTime();
+    for (auto & sample : error) {
+        auto start = PrecisionDelay::Now();
+        delay(target);
+        sample = (PrecisionDelay::Now() - start - target).count();
+    }
+    auto cpuPerCall = (threadCpuTime() - cpuStart) / samples;
+    std::sort(error.begin(), error.end());
+
+    auto at = [&](int percent) { return error[static_cast<std::size_t>(samples - 1) * percent / 100] / 1000.0; };
+    std::cout << std::fixed << std::setprecision(2)
+              << std::setw(14) << name << std::setw(10) << duration<double, std::micro>(target).count()
+              << std::setw(12) << at(50) << std::setw(12) << at(99) << std::setw(12) << error.back() / 1000.0
+              << std::setw(12) << duration<double, std::micro>(cpuPerCall).count() << std::endl;
+}
+
+int main() {
+    auto & precise = PrecisionDelay::Instance();
+    std::cout << "Calibrated slack: " << duration<double, std::micro>(precise.Slack()).count() << " us\n\n";
+    std::cout << std::setw(14) << "delay" << std::setw(10) << "target" << std::setw(12) << "p50 err"
+              << std::setw(12) << "p99 err" << std::setw(12) << "max err" << std::setw(12) << "cpu/call" << "  (us)\n";
+
+    const nanoseconds targets[] = {microseconds(1), microseconds(10), microseconds(100), milliseconds(1), milliseconds(10)};
+    for (auto target : targets) {
+        int samples = target >= milliseconds(10) ? 100 : 1000;
+        measure("PrecisionDelay", target, samples, [&](nanoseconds t) { precise.SleepFor(t); });
+        measure("sleep_for", target, samples, [](nanoseconds t) { std::this_thread::sleep_for(t); });
+    }
+
+    const auto period = microseconds(1000);
+    const int wakeups = 1000;
+    std::cout << "\nWake-up latency, " << period.count() << " us period\n"
+              << std::setw(14) << "mode" << std::setw(10) << "samples" << std::setw(12) << "min"
+              << std::setw(12) << "avg" << std::setw(12) << "p99" << std::setw(12) << "max" << "  (us)\n";
+    reportWakeup("normal", MCAL::MeasureWakeupLatency(period, wakeups));
+    {
+        // Steps that need privileges are skipped with a warning; say which ones took
+        MCAL::RealTimeScope realtime;
+        std::string mode = realtime.SchedulingApplied() ? "FIFO" : "no FIFO";
+        if (realtime.MemoryLocked()) mode += "+mlock";
+        reportWakeup(mode.c_str(), MCAL::MeasureWakeupLatency(period, wakeups));
+    }
+    return 0;
+}
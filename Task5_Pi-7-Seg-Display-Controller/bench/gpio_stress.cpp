@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include "gpio.hpp"
+#include "gpio_sim.hpp"
+#include "clock.hpp"
+
+// Multithreaded GpioPin stress test against the simulator backend.
+// Each round runs N threads for a fixed time and reports total pin operations
+// per second, first with one pin per thread, then with every thread on one pin.
+
+using namespace MCAL::GPIO;
+using Clock = std::chrono::steady_clock;
+
+static constexpr auto RoundTime = std::chrono::milliseconds(300);
+
+static double runRound(std::vector<GpioPin> & pins, unsigned threads, bool sharedPin) {
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::vector<unsigned long> ops(threads, 0);
+    std::vector<std::thread> workers;
+
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            GpioPin & pin = pins[sharedPin ? 0 : t];
+            unsigned long count = 0;
+            int level = 0;
+            while (!start.load(std::memory_order_acquire)) {}
+            while (!stop.load(std::memory_order_relaxed)) {
+                level ^= 1;
+                pin.SetPinVal(level);
+                int value = 0;
+                pin.GetPinValue(value);
+                count += 2;
+            }
+            ops[t] = count;
+        });
+    }
+
+    auto begin = Clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(RoundTime);
+    stop.store(true);
+    for (auto & worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+    unsigned long total = 0;
+    for (auto count : ops) total += count;
+    return total / seconds;
+}
+
+int main() {
+    unsigned maxThreads = std::thread::hardware_concurrency();
+    if (maxThreads == 0) maxThreads = 1;
+
+    // Skip the export settle delays; only the measured rounds use real time
+    MCAL::VirtualClock virtualClock;
+    MCAL::SetActiveClock(&virtualClock);
+
+    SysfsSimulator simulator(0, static_cast<int>(maxThreads));
+    std::vector<GpioPin> pins;
+    pins.reserve(maxThreads);
+    for (unsigned i = 0; i < maxThreads; i++)
+        pins.emplace_back(static_cast<int>(i), PinOUT, PinLow);
+
+    for (bool sharedPin : {false, true}) {
+        std::cout << (sharedPin ? "\n=== All threads on one pin ===" : "=== One pin per thread ===") << std::endl;
+        std::cout << std::setw(8) << "threads" << std::setw(16) << "ops/s" << std::setw(10) << "scale" << std::endl;
+        double baseline = 0;
+        // Powers of two, then maxThreads itself if it is not one
+        for (unsigned threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+            double rate = runRound(pins, threads, sharedPin);
+            if (threads == 1) baseline = rate;
+            std::cout << std::setw(8) << threads << std::setw(16) << std::fixed << std::setprecision(0) << rate
+                      << std::setw(9) << std::setprecision(2) << rate / baseline << "x" << std::endl;
+            if (threads == maxThreads) break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,283 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "DigitStreamReader.hpp"
+#include "SensorLogger.hpp"
+#include "SevenSegment.hpp"
+#include "SpscQueue.hpp"
+#include "TerminalDisplay.hpp"
+#include "Ticker.hpp"
+#include "clock.hpp"
+#include "gpio.hpp"
+#include "gpio_sim.hpp"
+#include "gpio_trace.hpp"
+#include "perf_counters.hpp"
+#include "terminal.hpp"
+
+// Allocation and syscall budgets for srclib's hot paths.
+//
+// Heap allocations are counted by replacing the global operator new.
+// Syscalls are counted by interposing the libc wrappers the library uses
+// (open/openat/close/read/write/pread/pwrite/poll): srclib is a shared
+// library, so its calls bind to the definitions in this executable, which
+// count and forward to libc. Calls libc makes internally are not seen.
+//
+// Each case runs its operation many times against the simulator backend
+// and checks the per-operation averages. Exit status 1 means a budget was
+// exceeded, so a CI job can run this binary directly. Each case also shows
+// its performance counters per operation, where perf_event_open allows.
+//
+// SevenSegment::writeDigit cannot get down to one syscall: sysfs has one
+// value file per pin, so it costs one pwrite per segment that changes
+// (unchanged segments are skipped). Its budgets are therefore the exact
+// counts for a 0..9 cycle (3 per digit on average) and for the worst case
+// (all 7 segments). Task4's SensorLogger comes from its pigpio-free header
+// and should cost one write() per line.
+
+namespace {
+
+    std::atomic<bool> counting{false};
+    std::atomic<unsigned long long> allocations{0};
+    std::atomic<unsigned long long> syscalls{0};
+
+    inline void countAllocation() {
+        if (counting.load(std::memory_order_relaxed)) allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void countSyscall() {
+        if (counting.load(std::memory_order_relaxed)) syscalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename Function>
+    Function next(const char * name) {
+        return reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+    }
+
+}
+
+// ---------- Counting allocator ----------
+void * operator new(std::size_t size) {
+    countAllocation();
+    if (void * memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+void * operator new[](std::size_t size) { return operator new(size); }
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    countAllocation();
+    return std::malloc(size ? size : 1);
+}
+void * operator new[](std::size_t size, const std::nothrow_t & tag) noexcept { return operator new(size, tag); }
+void operator delete(void * memory) noexcept { std::free(memory); }
+void operator delete[](void * memory) noexcept { std::free(memory); }
+void operator delete(void * memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void * memory, std::size_t) noexcept { std::free(memory); }
+
+// ---------- Counting syscall wrappers ----------
+extern "C" {
+
+int open(const char * path, int flags, ...) {
+    static auto real = next<int (*)(const char *, int, ...)>("open");
+    mode_t mode = 0;
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list args;
+        va_start(args, flags);
+        mode = static_cast<mode_t>(va_arg(args, int));
+        va_end(args);
+    }
+    countSyscall();
+    return real(path, flags, mode);
+}
+
+int openat(int dirFd, const char * path, int flags, ...) {
+    static auto real = next<int (*)(int, const char *, int, ...)>("openat");
+    mode_t mode = 0;
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        va_list args;
+        va_start(args, flags);
+        mode = static_cast<mode_t>(va_arg(args, int));
+        va_end(args);
+    }
+    countSyscall();
+    return real(dirFd, path, flags, mode);
+}
+
+int close(int fd) {
+    static auto real = next<int (*)(int)>("close");
+    countSyscall();
+    return real(fd);
+}
+
+ssize_t read(int fd, void * buffer, size_t size) {
+    static auto real = next<ssize_t (*)(int, void *, size_t)>("read");
+    countSyscall();
+    return real(fd, buffer, size);
+}
+
+ssize_t write(int fd, const void * buffer, size_t size) {
+    static auto real = next<ssize_t (*)(int, const void *, size_t)>("write");
+    countSyscall();
+    return real(fd, buffer, size);
+}
+
+ssize_t pread(int fd, void * buffer, size_t size, off_t offset) {
+    static auto real = next<ssize_t (*)(int, void *, size_t, off_t)>("pread");
+    countSyscall();
+    return real(fd, buffer, size, offset);
+}
+
+ssize_t pwrite(int fd, const void * buffer, size_t size, off_t offset) {
+    static auto real = next<ssize_t (*)(int, const void *, size_t, off_t)>("pwrite");
+    countSyscall();
+    return real(fd, buffer, size, offset);
+}
+
+int poll(struct pollfd * fds, nfds_t count, int timeout) {
+    static auto real = next<int (*)(struct pollfd *, nfds_t, int)>("poll");
+    countSyscall();
+    return real(fds, count, timeout);
+}
+
+}
+
+// ---------- Budgets ----------
+namespace {
+
+    struct Budget {
+        const char * Name;
+        double MaxSyscalls;         // per operation
+        double MaxAllocations;      // per operation
+    };
+
+    MCAL::PerfCounters * perf = nullptr;
+
+    bool withinBudget(const Budget & budget, int operations, const std::function<void(int)> & operation) {
+        operation(0);       // warm up: lazily opened descriptors, first buffers
+
+        allocations = 0;
+        syscalls = 0;
+        perf->Start();
+        counting = true;
+        for (int i = 1; i <= operations; i++) operation(i);
+        counting = false;
+        MCAL::PerfReading reading = perf->Stop(static_cast<std::uint64_t>(operations));
+
+        double perSyscalls = static_cast<double>(syscalls.load()) / operations;
+        double perAllocations = static_cast<double>(allocations.load()) / operations;
+        bool ok = perSyscalls <= budget.MaxSyscalls && perAllocations <= budget.MaxAllocations;
+
+        std::cout << std::left << std::setw(40) << budget.Name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(9) << perSyscalls << " /" << std::setw(6) << budget.MaxSyscalls
+                  << std::setw(10) << perAllocations << " /" << std::setw(6) << budget.MaxAllocations
+                  << (ok ? "   ok" : "   OVER BUDGET") << std::endl;
+        std::cout << "    " << reading << std::endl;
+        return ok;
+    }
+
+}
+
+int main() {
+    using namespace HardwareIO;
+    using namespace MCAL::GPIO;
+    constexpr int Operations = 10000;
+
+    std::streambuf * console = std::cout.rdbuf();
+    std::ofstream devNull("/dev/null");
+
+    // Simulated pins, set up without the export settle delays or the chatter
+    MCAL::VirtualClock setupClock;
+    MCAL::SetActiveClock(&setupClock);
+    SysfsSimulator simulator(0, 32);
+    std::cout.rdbuf(devNull.rdbuf());
+    std::vector<GpioPin> pins = GPIO_InitPins({0, 1, 2, 3}, PinOUT, PinLow);
+    SevenSegment segment;
+    std::cout.rdbuf(console);
+    MCAL::SetActiveClock(nullptr);
+
+    std::string digitsPath = "/tmp/hotpath_budget_digits.txt";
+    {
+        std::ofstream digits(digitsPath);
+        for (int i = 0; i < Operations + 1; i++) digits << static_cast<char>('0' + i % 10);
+    }
+    DigitStreamReader reader(digitsPath);
+
+    Terminal unbuffered(FlushPolicy{}, devNull);
+    FlushPolicy policy;
+    policy.Buffered = true;
+    Terminal buffered(policy, devNull);
+
+    SpscQueue<int> queue(64);
+    // Not started: a tick only publishes, the renderer is not what is measured
+    TerminalDisplay tickerDisplay(4, 60, devNull);
+    Ticker ticker(4);
+    ticker.load("HELLO 1234.5");
+    TickerPlayer player(30);
+    player.add(ticker, tickerDisplay);
+    MCAL::PerfCounters counters;
+    perf = &counters;
+    if (!counters.HardwareAvailable()) std::cout << "(hardware counters unavailable here)" << std::endl;
+    TraceRecorder trace("/tmp/hotpath_budget.trace", 1 << 16);
+    const char * sensorLogPath = "/tmp/hotpath_budget_sensor.log";
+    SensorLogger sensorLog(sensorLogPath);
+
+    std::cout << std::left << std::setw(40) << "operation" << std::right
+              << std::setw(17) << "syscalls/op" << std::setw(18) << "allocations/op" << std::endl;
+
+    bool ok = true;
+    ok &= withinBudget({"GpioPin::SetPinVal", 1, 0}, Operations,
+                       [&](int i) { pins[0].SetPinVal(i & 1); });
+    ok &= withinBudget({"GpioPin::GetPinValue(int&)", 1, 0}, Operations,
+                       [&](int) { int value; pins[0].GetPinValue(value); });
+    GpioPin unopened;
+    int unopenedStatus = 0;
+    ok &= withinBudget({"GpioPin::GetPinValue (no pin)", 0, 0}, Operations,
+                       [&](int) { int value; unopenedStatus = unopened.GetPinValue(value); });
+    if (unopenedStatus != -EBADF) {
+        std::cout << "    expected -EBADF, got " << unopenedStatus << std::endl;
+        ok = false;
+    }
+    ok &= withinBudget({"GPIO_Snapshot (4 pins)", 4, 0}, Operations,
+                       [&](int) { std::uint32_t mask; GPIO_Snapshot(pins, mask); });
+    ok &= withinBudget({"GPIO_WritePins (2 of 4 changed)", 2, 0}, Operations,
+                       [&](int i) { GPIO_WritePins(pins, (i & 1) ? 0x5u : 0xAu, 0x3u); });
+    // One pwrite per changed segment, see above
+    ok &= withinBudget({"SevenSegment::writeDigit (0..9 cycle)", 3, 0}, Operations,
+                       [&](int i) { segment.writeDigit(i % 10); });
+    ok &= withinBudget({"SevenSegment::writeDigit (8 <-> blank)", 7, 0}, Operations,
+                       [&](int i) { segment.writeDigit((i & 1) ? 8 : -1); });
+    ok &= withinBudget({"SevenSegment::writeDigit (same digit)", 0, 0}, Operations,
+                       [&](int) { segment.writeDigit(8); });
+    ok &= withinBudget({"Terminal::writeDigit (unbuffered)", 1, 0}, Operations,
+                       [&](int i) { unbuffered.writeDigit(i % 10); });
+    ok &= withinBudget({"Terminal::writeDigit (buffered)", 0.01, 0}, Operations,
+                       [&](int i) { buffered.writeDigit(i % 10); });
+    ok &= withinBudget({"DigitStreamReader::tryReadDigit", 0.01, 0}, Operations,
+                       [&](int) { reader.tryReadDigit(); });
+    ok &= withinBudget({"SpscQueue push + pop", 0, 0}, Operations,
+                       [&](int i) { int out; queue.push(i); queue.tryPop(out); });
+    ok &= withinBudget({"TraceRecorder::Record", 0, 0}, Operations,
+                       [&](int i) { trace.Record(TraceOp::Write, 0, i & 1); });
+    ok &= withinBudget({"TickerPlayer::tick (1 track)", 0, 0}, Operations,
+                       [&](int) { player.tick(); });
+
+    ok &= withinBudget({"SensorLogger::log (Task4)", 1, 0}, Operations,
+                       [&](int i) { sensorLog.log(SensorReading{20.0f + i % 10, 45.0f}); });
+
+    unlink(digitsPath.c_str());
+    unlink(sensorLogPath);
+    unlink("/tmp/hotpath_budget.trace");
+
+    std::cout.rdbuf(devNull.rdbuf());       // quiet unexports
+    return ok ? 0 : 1;
+}
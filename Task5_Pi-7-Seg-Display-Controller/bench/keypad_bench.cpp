@@ -0,0 +1,150 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "MatrixKeypad.hpp"
+#include "clock.hpp"
+#include "gpio_sim.hpp"
+
+// MatrixKeypad scan rate, CPU use and keypress latency on the simulator:
+// idle, with keys held, and for single taps from idle.
+//
+// The simulator has no row/column coupling, so a press is modelled by
+// holding a column line low. That reads as every key in the column being
+// down (four presses per tap). Regular files raise no edge interrupts
+// either, so an idle keypad wakes on its IdleScanHz fallback scan, and a tap
+// shorter than that period can be missed. On real sysfs GPIO the column edge
+// wakes it at once and the tap latency drops to roughly the debounce time.
+
+using namespace std::chrono;
+using namespace HardwareIO;
+
+namespace {
+
+    constexpr std::array<int, 4> Rows = {0, 1, 2, 3};
+    constexpr std::array<int, 4> Columns = {4, 5, 6, 7};
+    constexpr int Taps = 10;
+
+    struct Phase {
+        nanoseconds At{0};
+        unsigned long long Scans = 0;
+        double CpuNs = 0;       // scan thread CPU time since start()
+    };
+
+    // Phase boundaries, measured from the bench's own view of start()
+    Phase sample(const MatrixKeypad & keypad, nanoseconds started) {
+        KeypadStats stats = keypad.stats();
+        Phase phase;
+        phase.At = MCAL::ActiveClock().Now() - started;
+        phase.Scans = stats.Scans;
+        phase.CpuNs = stats.CpuPercent / 100.0 * phase.At.count();
+        return phase;
+    }
+
+    void report(const char * name, const Phase & from, const Phase & to) {
+        double seconds = duration<double>(to.At - from.At).count();
+        std::cout << std::setw(12) << name << std::setw(12) << std::setprecision(0) << (to.Scans - from.Scans) / seconds
+                  << std::setw(12) << std::setprecision(2) << 100.0 * (to.CpuNs - from.CpuNs) / (to.At - from.At).count()
+                  << std::endl;
+    }
+
+}
+
+int main() {
+    MCAL::GPIO::SysfsSimulator simulator(0, 8);
+
+    // Simulated exports need no settle time, and their chatter is not the report
+    MCAL::VirtualClock setupClock;
+    MCAL::SetActiveClock(&setupClock);
+    std::streambuf * console = std::cout.rdbuf(nullptr);
+    KeypadConfig config;
+    config.RowPins = Rows;
+    config.ColumnPins = Columns;
+    MatrixKeypad keypad(config);
+    std::cout.rdbuf(console);
+    MCAL::SetActiveClock(nullptr);
+
+    // Column inputs idle high, as with the pull-ups
+    std::array<int, 4> columnFds;
+    for (std::size_t i = 0; i < Columns.size(); i++) {
+        std::string path = simulator.Root() + "/gpio" + std::to_string(MCAL::GPIO::GPIO_BASE + Columns[i]) + "/value";
+        columnFds[i] = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (columnFds[i] < 0 || pwrite(columnFds[i], "1", 1, 0) != 1) {
+            std::cerr << "Error: can't drive simulated column " << path << std::endl;
+            return 1;
+        }
+    }
+    auto setColumn = [&](std::size_t column, bool down) { pwrite(columnFds[column], down ? "0" : "1", 1, 0); };
+
+    // Tap latency from the bench's side: column pulled low -> press read
+    std::atomic<long long> pressedAt{0};
+    std::vector<long long> tapLatency;
+    std::thread reader([&] {
+        KeyEvent event;
+        while (keypad.readKey(event)) {
+            if (!event.Pressed) continue;
+            long long at = pressedAt.exchange(0);
+            if (at != 0) tapLatency.push_back(MCAL::ActiveClock().Now().count() - at);
+        }
+    });
+
+    auto started = MCAL::ActiveClock().Now();
+    keypad.start();
+
+    // Past IdleAfter, so the first phase is idle throughout
+    std::this_thread::sleep_for(config.IdleAfter + milliseconds(50));
+    Phase idleStart = sample(keypad, started);
+    std::this_thread::sleep_for(seconds(1));
+    Phase idleEnd = sample(keypad, started);
+    bool wentIdle = keypad.stats().Idle;
+
+    setColumn(0, true);
+    std::this_thread::sleep_for(milliseconds(100));
+    Phase heldStart = sample(keypad, started);
+    std::this_thread::sleep_for(seconds(1));
+    Phase heldEnd = sample(keypad, started);
+    setColumn(0, false);
+
+    for (int tap = 0; tap < Taps; tap++) {
+        // Staggered, so the taps do not all land at the same point of the idle scan period
+        std::this_thread::sleep_for(config.IdleAfter + milliseconds(100 + 7 * tap));
+        pressedAt = MCAL::ActiveClock().Now().count();
+        setColumn(tap % Columns.size(), true);
+        std::this_thread::sleep_for(milliseconds(80));     // a quick human tap, longer than the idle scan period
+        setColumn(tap % Columns.size(), false);
+    }
+    std::this_thread::sleep_for(milliseconds(50));
+
+    keypad.stop();
+    reader.join();
+    for (int fd : columnFds) close(fd);
+    KeypadStats stats = keypad.stats();
+
+    std::cout << std::fixed << std::setw(12) << "phase" << std::setw(12) << "scans/s" << std::setw(12) << "cpu %" << std::endl;
+    report(wentIdle ? "idle" : "idle (busy)", idleStart, idleEnd);
+    report("keys held", heldStart, heldEnd);
+
+    std::sort(tapLatency.begin(), tapLatency.end());
+    auto ms = [](long long ns) { return ns / 1e6; };
+    std::cout << std::setprecision(2) << "\nTaps from idle: " << tapLatency.size() << "/" << Taps << " read";
+    if (!tapLatency.empty()) {
+        std::cout << ", press -> read p50 " << ms(tapLatency[tapLatency.size() / 2])
+                  << " ms, max " << ms(tapLatency.back()) << " ms";
+    }
+    std::cout << "\nKeypad stats: " << stats.Scans << " scans at " << std::setprecision(0) << stats.ScanHz << "/s, "
+              << std::setprecision(2) << stats.CpuPercent << "% cpu, " << stats.Presses << " presses, "
+              << stats.Ghosts << " ghosts, " << stats.Dropped << " dropped\n"
+              << "Keypad latency (first seen -> read): mean " << ms(stats.MeanLatency.count())
+              << " ms, max " << ms(stats.MaxLatency.count()) << " ms" << std::endl;
+
+    // Quiet unexports
+    std::cout.rdbuf(nullptr);
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include "MultiplexedDisplay.hpp"
+#include "clock.hpp"
+#include "gpio_sim.hpp"
+#include "gpio_trace.hpp"
+#include "precision_delay.hpp"
+
+// MultiplexedDisplay refresh rate, jitter and GPIO writes per slot on the
+// simulator: 8 digits at 1 kHz with changing and static content, then
+// parked on a single lit digit and on a blank frame, then resumed, and
+// finally dimmed so every slot runs the 8 brightness planes.
+//
+// Writes are counted with a TraceRecorder, which sees every GpioPin write
+// without adding syscalls. Writes per slot carry over to the Pi as they
+// are; slot timing and jitter depend on the machine and its scheduler.
+// CPU is the whole process's, which is the refresh thread while the bench
+// sleeps.
+
+using namespace std::chrono;
+using namespace HardwareIO;
+
+namespace {
+
+    constexpr int SegmentPinCount = 7;
+    constexpr int DigitPinCount = 8;
+    constexpr unsigned RefreshHz = 1000;
+    const char * TracePath = "/tmp/multiplex_bench.trace";
+
+    struct Sample {
+        nanoseconds At{0};
+        unsigned long long Slots = 0;
+        std::uint64_t Writes = 0;
+        nanoseconds Cpu{0};
+    };
+
+    nanoseconds processCpu() {
+        timespec ts;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+        return seconds(ts.tv_sec) + nanoseconds(ts.tv_nsec);
+    }
+
+    Sample sample(const MultiplexedDisplay & display, const MCAL::GPIO::TraceRecorder & trace) {
+        Sample s;
+        s.At = MCAL::ActiveClock().Now();
+        s.Slots = display.stats().Slots;
+        s.Writes = trace.EventCount();
+        s.Cpu = processCpu();
+        return s;
+    }
+
+    void report(const char * name, const MultiplexedDisplay & display, const Sample & from, const Sample & to) {
+        double seconds = duration<double>(to.At - from.At).count();
+        unsigned long long slots = to.Slots - from.Slots;
+        std::uint64_t writes = to.Writes - from.Writes;
+        std::cout << std::setw(16) << name << std::setw(10) << std::setprecision(0) << slots / seconds
+                  << std::setw(10) << writes << std::setw(12) << std::setprecision(2);
+        // A refresh cycle lights every digit once
+        if (slots > 0) std::cout << static_cast<double>(writes) / slots << std::setw(13) << static_cast<double>(writes) * DigitPinCount / slots;
+        else std::cout << "-" << std::setw(13) << "-";
+        std::cout << std::setw(8) << 100.0 * (to.Cpu - from.Cpu).count() / (to.At - from.At).count()
+                  << std::setw(8) << (display.stats().Parked ? "yes" : "no") << std::endl;
+    }
+
+}
+
+int main() {
+    MCAL::GPIO::SysfsSimulator simulator(0, SegmentPinCount + DigitPinCount);
+
+    // Simulated exports need no settle time, and their chatter is not the report
+    MCAL::VirtualClock setupClock;
+    MCAL::SetActiveClock(&setupClock);
+    std::streambuf * console = std::cout.rdbuf(nullptr);
+    MultiplexConfig config;
+    for (int pin = 0; pin < SegmentPinCount; pin++) config.SegmentPins.push_back(pin);
+    for (int pin = 0; pin < DigitPinCount; pin++) config.DigitPins.push_back(SegmentPinCount + pin);
+    config.RefreshHz = RefreshHz;
+    MultiplexedDisplay display(config);
+    std::cout.rdbuf(console);
+    MCAL::SetActiveClock(nullptr);
+
+    MCAL::GPIO::TraceRecorder trace(TracePath, 1 << 16);
+    MCAL::GPIO::GPIO_SetTraceRecorder(&trace);
+
+    std::cout << std::fixed << DigitPinCount << " digits at " << RefreshHz << " slots/s\n"
+              << std::setw(16) << "phase" << std::setw(10) << "slots/s" << std::setw(10) << "writes"
+              << std::setw(12) << "writes/slot" << std::setw(13) << "writes/cycle" << std::setw(8) << "cpu %"
+              << std::setw(8) << "parked" << std::endl;
+
+    display.setText("12345678");
+    display.start();
+    std::this_thread::sleep_for(milliseconds(100));
+
+    // A counter: the low digits change ten times a second
+    Sample from = sample(display, trace);
+    for (int step = 0; step < 10; step++) {
+        char text[DigitPinCount + 1];
+        std::snprintf(text, sizeof text, "%08d", 12345678 + step * 1111);
+        display.setText(text);
+        std::this_thread::sleep_for(milliseconds(100));
+    }
+    Sample to = sample(display, trace);
+    report("counting", display, from, to);
+
+    // Static multi-digit content still has to be scanned
+    display.setText("88888888");
+    std::this_thread::sleep_for(milliseconds(50));
+    from = sample(display, trace);
+    std::this_thread::sleep_for(milliseconds(500));
+    to = sample(display, trace);
+    report("static 8 digits", display, from, to);
+
+    // Nothing to multiplex: latched and parked, no slots and no writes
+    display.setText("8");
+    std::this_thread::sleep_for(milliseconds(50));
+    from = sample(display, trace);
+    std::this_thread::sleep_for(milliseconds(500));
+    to = sample(display, trace);
+    report("single digit", display, from, to);
+
+    display.clear();
+    std::this_thread::sleep_for(milliseconds(50));
+    from = sample(display, trace);
+    std::this_thread::sleep_for(milliseconds(500));
+    to = sample(display, trace);
+    report("blank", display, from, to);
+
+    display.setText("87654321");
+    std::this_thread::sleep_for(milliseconds(50));
+    from = sample(display, trace);
+    std::this_thread::sleep_for(milliseconds(500));
+    to = sample(display, trace);
+    report("resumed", display, from, to);
+
+    // Binary-code modulation: 8 planes per slot, the short ones spun out.
+    // 0x55 lights every other plane, the most enable/disable toggles a level can cost.
+    display.setBrightness(0x55);
+    std::this_thread::sleep_for(milliseconds(50));
+    from = sample(display, trace);
+    std::this_thread::sleep_for(milliseconds(500));
+    to = sample(display, trace);
+    report("dimmed 8 digits", display, from, to);
+
+    display.stop();
+    MCAL::GPIO::GPIO_SetTraceRecorder(nullptr);
+    std::remove(TracePath);
+
+    RefreshStats stats = display.stats();
+    std::cout << "\nRefresh stats: " << stats.Slots << " slots at " << std::setprecision(0) << stats.AchievedHz
+              << "/s while running, jitter mean " << std::setprecision(1) << stats.MeanJitter.count() / 1e3
+              << " us, max " << stats.MaxJitter.count() / 1e3 << " us\n"
+              << "Dimmed slots spin for up to " << MCAL::PrecisionDelay::Instance().Slack().count() / 1e3
+              << " us of sleep slack per plane" << std::endl;
+
+    // Quiet unexports
+    std::cout.rdbuf(nullptr);
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "ShiftRegisterDisplay.hpp"
+#include "clock.hpp"
+#include "gpio_sim.hpp"
+#include "gpio_trace.hpp"
+
+// ShiftRegisterDisplay throughput on the simulator: a writer publishes
+// frames as fast as it can for half a second while the driver shifts out
+// whatever frame is newest. Reports the driver's own stats and checks, from
+// a TraceRecorder trace of every pin write, that each latched frame cost
+// exactly one latch pulse and that frames the driver never saw cost none.
+
+using namespace std::chrono;
+using namespace HardwareIO;
+
+namespace {
+
+    constexpr int DataPin = 0;
+    constexpr int ClockPin = 1;
+    constexpr int LatchPin = 2;
+    constexpr std::size_t Digits = 8;
+    const char * TracePath = "/tmp/shift_register_bench.trace";
+    constexpr std::size_t TraceCapacity = 1 << 21;
+
+}
+
+int main() {
+    MCAL::GPIO::SysfsSimulator simulator(0, 3);
+
+    // Simulated exports need no settle time, and their chatter is not the report
+    MCAL::VirtualClock setupClock;
+    MCAL::SetActiveClock(&setupClock);
+    std::streambuf * console = std::cout.rdbuf(nullptr);
+    ShiftRegisterConfig config;
+    config.DataPin = DataPin;
+    config.ClockPin = ClockPin;
+    config.LatchPin = LatchPin;
+    config.Digits = Digits;
+    ShiftRegisterDisplay display(config);
+    std::cout.rdbuf(console);
+    MCAL::SetActiveClock(nullptr);
+
+    MCAL::GPIO::TraceRecorder trace(TracePath, TraceCapacity);
+    MCAL::GPIO::GPIO_SetTraceRecorder(&trace);
+    display.start();
+
+    unsigned long long published = 0;
+    auto started = steady_clock::now();
+    while (steady_clock::now() - started < milliseconds(500)) {
+        char text[Digits + 1];
+        std::snprintf(text, sizeof text, "%08llu", published % 100000000ULL);
+        display.setText(text);
+        published++;
+    }
+    double elapsed = duration<double>(steady_clock::now() - started).count();
+
+    display.stop();
+    MCAL::GPIO::GPIO_SetTraceRecorder(nullptr);
+    std::uint64_t recorded = trace.EventCount();
+    ShiftRegisterStats stats = display.stats();
+
+    std::cout << std::fixed << std::setprecision(0) << Digits << " digits, " << published << " frames published, "
+              << stats.Frames << " latched (" << stats.Frames / elapsed << " frames/s)\n"
+              << "Shift stats: " << stats.DigitsPerSecond << " digits/s while shifting, "
+              << std::setprecision(1) << stats.GpioWritesPerFrame << " GPIO writes per frame" << std::endl;
+
+    if (recorded > TraceCapacity) {
+        std::cerr << "Error: trace ring overflowed (" << recorded << " events), latch pulses not counted" << std::endl;
+        std::remove(TracePath);
+        std::cout.rdbuf(nullptr);
+        return 1;
+    }
+
+    unsigned long long latchPulses = 0;
+    for (const auto & event : MCAL::GPIO::GPIO_LoadTrace(TracePath)) {
+        if (event.Op == MCAL::GPIO::TraceOp::Write && event.Pin == LatchPin && event.Value == MCAL::GPIO::PinHigh)
+            latchPulses++;
+    }
+    std::remove(TracePath);
+
+    bool onePerFrame = latchPulses == stats.Frames;
+    std::cout << "Latch pulses: " << latchPulses << " for " << stats.Frames << " frames"
+              << (onePerFrame ? ", one per frame" : ", MISMATCH") << std::endl;
+
+    // Quiet unexports
+    std::cout.rdbuf(nullptr);
+    return onePerFrame ? 0 : 1;
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include "terminal.hpp"
+
+// Digits per second through Terminal into a sink (default /dev/null, or the
+// file/pipe given as argv[1]): the original one-flush-per-digit behaviour
+// against the buffered flush policy.
+
+using namespace HardwareIO;
+
+static double digitsPerSecond(Terminal & terminal, int digits) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < digits; i++) terminal.writeDigit(i % 10);
+    terminal.flush();
+    return digits / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char * argv[]) {
+    const char * sinkPath = argc > 1 ? argv[1] : "/dev/null";
+    constexpr int Digits = 1000000;
+
+    std::ofstream sink(sinkPath);
+    if (!sink) {
+        std::cerr << "Can't open " << sinkPath << std::endl;
+        return 1;
+    }
+
+    Terminal unbuffered(FlushPolicy{}, sink);
+    FlushPolicy buffered;
+    buffered.Buffered = true;
+    Terminal batched(buffered, sink);
+
+    double before = digitsPerSecond(unbuffered, Digits);
+    double after = digitsPerSecond(batched, Digits);
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "Sink: " << sinkPath << ", " << Digits << " digits\n"
+              << std::setw(12) << "endl/digit" << std::setw(14) << before << " digits/s\n"
+              << std::setw(12) << "buffered" << std::setw(14) << after << " digits/s  ("
+              << std::setprecision(1) << after / before << "x)\n";
+    return 0;
+}
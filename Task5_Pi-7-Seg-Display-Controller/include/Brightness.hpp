@@ -0,0 +1,32 @@
+#pragma once
+#include "glyphs.hpp"
+#include <array>
+#include <cstdint>
+
+namespace HardwareIO{
+
+    // Binary code modulation: an 8-bit brightness is shown as 8 bit-planes,
+    // plane k lasting 2^k time units. A segment is lit in plane k when bit k
+    // of its brightness is set, so 8 plane updates per refresh replace the
+    // 256 steps a software PWM would need.
+    constexpr std::size_t BrightnessPlanes = 8;
+    constexpr std::uint8_t FullBrightness = 255;
+
+    using SegmentLevels = std::array<std::uint8_t, 8>;      // per segment a..g, dp
+    using PlaneMasks = std::array<SegmentMask, BrightnessPlanes>;
+
+    constexpr PlaneMasks buildPlanes(SegmentMask mask, const SegmentLevels & levels){
+        PlaneMasks planes{};
+        for (std::size_t segment = 0; segment < 8; segment++) {
+            if (!(mask & (1u << segment))) continue;
+            for (std::size_t plane = 0; plane < BrightnessPlanes; plane++) {
+                if (levels[segment] & (1u << plane)) planes[plane] |= static_cast<SegmentMask>(1u << segment);
+            }
+        }
+        return planes;
+    }
+
+    static_assert(buildPlanes(SegA | SegB, SegmentLevels{255, 1, 0, 0, 0, 0, 0, 0})[0] == (SegA | SegB), "plane 0");
+    static_assert(buildPlanes(SegA | SegB, SegmentLevels{255, 1, 0, 0, 0, 0, 0, 0})[7] == SegA, "plane 7");
+
+}
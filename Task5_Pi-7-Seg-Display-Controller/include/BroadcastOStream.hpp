@@ -0,0 +1,82 @@
+#pragma once
+#include "OStream.hpp"
+#include "SpscQueue.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace HardwareIO{
+
+    struct SinkConfig {
+        std::string Name;
+        std::size_t QueueCapacity = 256;
+        Backpressure Policy = Backpressure::DropOldest;
+    };
+
+    struct SinkStats {
+        std::string Name;
+        QueueStats Queue;
+        unsigned long long Written = 0;         // writeDigit succeeded
+        unsigned long long Errors = 0;          // writeDigit threw (not counted as written)
+        unsigned long long Lag = 0;             // broadcast, not yet written, failed or dropped
+        std::chrono::nanoseconds MaxLatency{0}; // broadcast -> written
+    };
+
+    // One OStream that forwards every digit to several sinks (a display, a
+    // terminal mirror, a log). Each sink has its own SPSC queue and worker
+    // thread, so writeDigit only enqueues and a slow or stuck sink falls
+    // behind on its own instead of delaying the rest; with the default
+    // DropOldest policy it skips ahead to the newest digits once it catches up.
+    //
+    // Add every sink before the first writeDigit, and call writeDigit from a
+    // single thread (it is each queue's only producer).
+    class BroadcastOStream final : public OStream {
+        private:
+            struct Item {
+                int digit;
+                long long queuedNs;
+            };
+
+            struct Sink {
+                std::shared_ptr<OStream> output;
+                std::string name;
+                SpscQueue<Item> queue;
+                std::thread worker;
+                std::atomic<unsigned long long> written{0};
+                std::atomic<unsigned long long> errors{0};
+                std::atomic<long long> maxLatencyNs{0};
+
+                Sink(std::shared_ptr<OStream> sink, const SinkConfig & config)
+                    : output(std::move(sink)), name(config.Name), queue(config.QueueCapacity, config.Policy) {}
+            };
+
+            std::vector<std::unique_ptr<Sink>> sinks;
+            std::atomic<unsigned long long> broadcast{0};   // stats() may run on any thread
+
+            static void drain(Sink & sink);
+
+        public:
+            BroadcastOStream() = default;
+
+            BroadcastOStream(const BroadcastOStream&) = delete;
+            BroadcastOStream& operator=(const BroadcastOStream&) = delete;
+
+            // Starts the sink's worker; returns the sink's index for stats
+            std::size_t addSink(std::shared_ptr<OStream> sink, const SinkConfig & config = SinkConfig{});
+
+            void writeDigit(int digit) override;
+
+            // Block until every sink has written everything queued so far
+            void flush();
+
+            std::size_t sinkCount() const { return sinks.size(); }
+            SinkStats stats(std::size_t index) const;
+
+            // Drains the queues, then joins the workers
+            ~BroadcastOStream();
+    };
+
+}
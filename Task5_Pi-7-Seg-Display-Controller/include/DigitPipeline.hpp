@@ -0,0 +1,90 @@
+#pragma once
+#include "IStream.hpp"
+#include "OStream.hpp"
+#include "SpscQueue.hpp"
+#include <chrono>
+#include <exception>
+#include <functional>
+
+namespace HardwareIO{
+
+    struct PipelineConfig {
+        std::size_t QueueCapacity = 1024;
+        Backpressure Policy = Backpressure::Block;
+    };
+
+    struct StageLatency {
+        unsigned long long Count = 0;
+        std::chrono::nanoseconds Avg{0};
+        std::chrono::nanoseconds Max{0};
+    };
+
+    struct PipelineStats {
+        QueueStats Queue;
+        StageLatency Read;          // time inside tryReadDigit
+        StageLatency QueueWait;     // push -> pop
+        StageLatency Write;         // time inside writeDigit
+        unsigned long long InputErrors = 0;
+    };
+
+    // Reader and writer stages on separate threads, joined by a bounded SPSC
+    // queue, so a slow display no longer stalls input and a slow input no
+    // longer idles the display. The stats show which side is the bottleneck:
+    // a full queue and long QueueWait mean the writer is slow, an empty queue
+    // and long Read mean the input is.
+    class DigitPipeline {
+        public:
+            // Reader thread, after every read; return false to stop reading
+            std::function<bool()> KeepReading;
+            // Reader thread, for each rejected character
+            std::function<void(InputError)> OnInputError;
+            // Writer thread, after each digit reaches the output
+            std::function<void(int)> OnWritten;
+            // Writer thread, when the output rejects a digit
+            std::function<void(const std::exception&)> OnWriteError;
+
+        private:
+            struct Item {
+                int digit;
+                long long queuedNs;
+            };
+
+            struct LatencyCounter {
+                std::atomic<unsigned long long> count{0};
+                std::atomic<long long> sumNs{0};
+                std::atomic<long long> maxNs{0};
+
+                void add(long long ns);
+                StageLatency snapshot() const;
+            };
+
+            IStream & input;
+            OStream & output;
+            SpscQueue<Item> queue;
+
+            LatencyCounter readLatency;
+            LatencyCounter waitLatency;
+            LatencyCounter writeLatency;
+            std::atomic<unsigned long long> inputErrors{0};
+            std::atomic<bool> stopping{false};
+
+            void readerStage();
+            void writerStage();
+
+        public:
+            DigitPipeline(IStream & in, OStream & out, const PipelineConfig & config = PipelineConfig{});
+
+            DigitPipeline(const DigitPipeline&) = delete;
+            DigitPipeline& operator=(const DigitPipeline&) = delete;
+
+            // Run both stages until the input ends (or KeepReading says stop)
+            // and every queued digit has been written. An exception from either
+            // stage (or a callback) is rethrown once both threads have stopped.
+            void run();
+            // Ask the reader to stop after its current read
+            void stop() { stopping = true; }
+
+            PipelineStats stats() const;
+    };
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "IStream.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace HardwareIO{
+
+    // Prompt-free digit source for replaying large digit streams into the
+    // output devices. Regular files are mmap'ed, pipes and stdin ("-") are
+    // read in 64 KiB blocks. Each block is validated 8 bytes at a time with a
+    // SWAR range check; whitespace is skipped and any other byte is reported
+    // as invalid input when its turn comes.
+    class DigitStreamReader final : public IStream {
+        private:
+            static constexpr std::size_t BlockSize = 64 * 1024;
+            static constexpr std::uint8_t Invalid = 0xFF;
+
+            int fd = -1;
+            bool ownsFd = false;
+            const unsigned char * mapped = nullptr;     // whole file when mmap'ed
+            std::size_t mappedSize = 0;
+            std::size_t mappedOffset = 0;
+            bool endOfInput = false;
+
+            std::array<unsigned char, BlockSize> raw;
+            std::array<std::uint8_t, BlockSize> values;  // decoded digits (or Invalid)
+            std::size_t head = 0;
+            std::size_t tail = 0;
+
+            bool refill();
+            void decode(const unsigned char * data, std::size_t size);
+
+        public:
+            // path "-" reads standard input
+            explicit DigitStreamReader(const std::string & path);
+            explicit DigitStreamReader(int fileDescriptor);
+
+            DigitStreamReader(const DigitStreamReader&) = delete;
+            DigitStreamReader& operator=(const DigitStreamReader&) = delete;
+
+            // Next digit, NotADigit for a non-digit byte, EndOfInput once the
+            // input is exhausted
+            DigitResult tryReadDigit() noexcept override;
+
+            // Copy up to max digits (stops before an invalid byte). Returns the
+            // number copied. If stoppedBy is given it says why fewer than max
+            // were copied: NotADigit (the next tryReadDigit consumes the bad
+            // byte), EndOfInput, or None when max digits were copied.
+            std::size_t readDigits(std::uint8_t * out, std::size_t max, InputError * stoppedBy = nullptr);
+
+            bool eof();
+
+            ~DigitStreamReader();
+    };
+
+}
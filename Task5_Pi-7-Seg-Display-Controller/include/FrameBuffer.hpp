@@ -0,0 +1,57 @@
+#pragma once
+#include "glyphs.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace HardwareIO{
+
+    constexpr std::size_t MaxFrameDigits = 8;
+    using Frame = std::array<SegmentMask, MaxFrameDigits>;
+
+    // Lock-free frame hand-off between one writer and one display driver
+    // thread (triple buffering). The writer composes into back() and
+    // publish() swaps it with the shared middle slot in one atomic exchange;
+    // the driver's acquire() swaps the middle slot into front(). The driver
+    // therefore never sees a half-written frame, and neither side waits on
+    // the other however slow the GPIO backend is.
+    class FrameBuffer {
+        private:
+            static constexpr std::uint8_t IndexMask = 0x3;
+            static constexpr std::uint8_t Fresh = 0x4;   // middle holds an unread frame
+
+            std::array<Frame, 3> buffers{};
+            std::uint8_t backIndex = 0;                   // writer only
+            std::uint8_t frontIndex = 2;                  // driver only
+            std::atomic<std::uint8_t> middle{1};
+            std::atomic<std::uint64_t> published{0};
+
+        public:
+            // Writer side
+            Frame & back() { return buffers[backIndex]; }
+
+            // Make back() visible to the driver. The new back buffer starts as
+            // a copy of what was just published, so edits stay incremental.
+            void publish() {
+                const Frame composed = buffers[backIndex];
+                backIndex = middle.exchange(backIndex | Fresh) & IndexMask;
+                buffers[backIndex] = composed;
+                published.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Driver side
+            bool hasFresh() const { return middle.load() & Fresh; }
+
+            // Take the latest published frame, if any; false = front() unchanged
+            bool acquire() {
+                if (!(middle.load(std::memory_order_acquire) & Fresh)) return false;
+                frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & IndexMask;
+                return true;
+            }
+
+            const Frame & front() const { return buffers[frontIndex]; }
+
+            std::uint64_t publishedFrames() const { return published.load(std::memory_order_relaxed); }
+    };
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "OStream.hpp"
+#include "FrameBuffer.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace HardwareIO{
+
+    // Output device whose digits are shown by a driver thread. Writes only
+    // compose a frame and publish it through the FrameBuffer, so they cost
+    // nanoseconds and never block on GPIO. One thread writes at a time.
+    // Drivers with nothing to do park in waitForFrame() and are woken by
+    // the next publish.
+    class FramedOStream : public OStream {
+        private:
+            std::size_t digits;
+
+            std::mutex parkMutex;
+            std::condition_variable wake;
+            std::atomic<bool> parked{false};
+            std::atomic<bool> stopping{false};
+            std::atomic<bool> nudged{false};
+
+        protected:
+            FrameBuffer frames;
+
+            // Publish back() and wake a parked driver (frame writer only)
+            void commit();
+            // Wake a parked driver without publishing, for settings it reads
+            // itself (e.g. brightness); safe from any thread
+            void wakeDriver();
+
+            explicit FramedOStream(std::size_t digitCount);
+
+            // Driver side: block until a frame is published, wakeDriver() is
+            // called or a stop is requested. Returns false when stopping.
+            bool waitForFrame();
+            bool stopRequested() const { return stopping.load(std::memory_order_relaxed); }
+            bool isParked() const { return parked.load(std::memory_order_relaxed); }
+
+            // Owner side, around starting and joining the driver thread
+            void clearStop() { stopping = false; }
+            void requestStop();
+
+        public:
+            std::size_t digitCount() const { return digits; }
+
+            // Shift the display left and append x (0..15) on the right
+            void writeDigit(int x) override;
+            void setDigit(std::size_t position, SegmentMask mask);
+            // Left-aligned, '.' merges into the previous digit's decimal point
+            void setText(const char * text);
+            // Replace the whole frame (positions past digitCount() are ignored)
+            void setFrame(const Frame & frame);
+            void clear();
+    };
+
+}
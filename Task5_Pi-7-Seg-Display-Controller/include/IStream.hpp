@@ -5,11 +5,34 @@
 
 namespace HardwareIO{
 
+    enum class InputError {
+        None,
+        NotADigit,
+        EndOfInput
+    };
+
+    // Value or error code, returned by the non-throwing read path
+    struct DigitResult {
+        int value = 0;
+        InputError error = InputError::None;
+
+        explicit operator bool() const { return error == InputError::None; }
+    };
+
+    const char * describe(InputError error);
+
     class IStream : virtual public Stream{
         private:
 
         public:
             IStream() = default;
+
+            // Never throws: bad input is an error code, not an exception.
+            // Prompts on stdin by default; other input sources override it.
+            virtual DigitResult tryReadDigit() noexcept;
+
+            // Throwing wrapper: std::invalid_argument for a non-digit,
+            // std::runtime_error at end of input
             int readDigit();
 
     };
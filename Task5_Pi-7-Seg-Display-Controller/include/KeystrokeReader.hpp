@@ -0,0 +1,50 @@
+#pragma once
+#include "IStream.hpp"
+#include <chrono>
+#include <termios.h>
+#include <unistd.h>
+
+namespace HardwareIO{
+
+    struct Keystroke {
+        char Key = 0;
+        std::chrono::nanoseconds Time{0};   // ActiveClock time the byte was read
+    };
+
+    // Keystroke input without Enter: while alive, a terminal on fd is put in
+    // non-canonical, no-echo mode (VMIN=1, VTIME=0) and each key is returned
+    // as soon as poll() sees it. Signal keys still work; the original termios
+    // settings come back on destruction, exit(), SIGINT/SIGTERM/SIGHUP/SIGQUIT
+    // (which then take their default action) and around SIGTSTP/SIGCONT.
+    // If fd is not a terminal it is read unchanged, byte by byte.
+    //
+    // Only one reader may hold a terminal in raw mode at a time.
+    class KeystrokeReader final : public IStream {
+        private:
+            int fd;
+            bool raw = false;
+            std::chrono::nanoseconds lastKey{0};
+
+        public:
+            explicit KeystrokeReader(int fileDescriptor = STDIN_FILENO);
+
+            KeystrokeReader(const KeystrokeReader&) = delete;
+            KeystrokeReader& operator=(const KeystrokeReader&) = delete;
+
+            bool isRaw() const { return raw; }
+
+            // Wait up to timeout (negative: forever) for one key. false on
+            // timeout, end of input or a read error.
+            bool readKey(Keystroke & key, std::chrono::milliseconds timeout = std::chrono::milliseconds(-1));
+
+            // Digits as typed; 'q', 'Q', Ctrl-D and end of input end the
+            // stream, Enter and spaces are skipped, other keys are NotADigit
+            DigitResult tryReadDigit() noexcept override;
+
+            // Timestamp of the last key returned
+            std::chrono::nanoseconds lastKeyTime() const { return lastKey; }
+
+            ~KeystrokeReader();
+    };
+
+}
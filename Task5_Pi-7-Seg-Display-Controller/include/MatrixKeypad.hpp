@@ -0,0 +1,120 @@
+#pragma once
+#include "IStream.hpp"
+#include "SpscQueue.hpp"
+#include "gpio.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace HardwareIO{
+
+    struct KeypadConfig {
+        std::array<int, 4> RowPins;         // outputs, driven low one at a time
+        std::array<int, 4> ColumnPins;      // inputs with pull-ups: low = key down in the driven row
+        std::array<char, 16> Keymap = {'1', '2', '3', 'A',
+                                       '4', '5', '6', 'B',
+                                       '7', '8', '9', 'C',
+                                       '*', '0', '#', 'D'};   // row-major
+        unsigned ActiveScanHz = 1000;               // while keys are down or recently used
+        unsigned IdleScanHz = 20;                   // fallback when no edge interrupt arrives
+        std::chrono::milliseconds IdleAfter{250};   // quiet time before going idle
+        std::chrono::milliseconds Debounce{5};      // a key must hold a new state this long
+        std::size_t QueueCapacity = 64;             // undelivered key events (oldest dropped)
+        bool SuppressGhosts = true;                 // false for a matrix with a diode per key
+    };
+
+    struct KeyEvent {
+        char Key = 0;
+        bool Pressed = false;                   // false: released
+        std::chrono::nanoseconds FirstSeen{0};  // scan that first saw the change
+        std::chrono::nanoseconds Reported{0};   // debounce accepted it
+    };
+
+    struct KeypadStats {
+        double ScanHz = 0;                          // full matrix scans per second since start()
+        unsigned long long Scans = 0;
+        unsigned long long Presses = 0;
+        unsigned long long Ghosts = 0;              // presses suppressed as matrix ghosts
+        unsigned long long Dropped = 0;             // events lost to a full queue
+        double CpuPercent = 0;                      // scan thread CPU time / wall time
+        std::chrono::nanoseconds MeanLatency{0};    // first seen -> delivered to the reader
+        std::chrono::nanoseconds MaxLatency{0};
+        bool Idle = false;                          // waiting for an edge right now
+    };
+
+    // 4x4 matrix keypad as an input stream. A scan thread drives one row low
+    // at a time with GPIO_WritePins and reads all four columns with
+    // GPIO_Snapshot, so a scan is 4 row writes (only the lines that change)
+    // and 4 column reads.
+    //
+    // Every key is debounced on its own and reported on its own, so any number
+    // of keys can be down at once (n-key rollover). That needs a diode per key;
+    // without diodes three keys on the corners of a rectangle make the fourth
+    // look pressed, so by default a press that completes a rectangle is
+    // suppressed and counted as a ghost. With diodes, set SuppressGhosts to
+    // false and real rectangle chords are reported.
+    //
+    // Scheduling: while a key is down, or for IdleAfter after the last change,
+    // the matrix is scanned at ActiveScanHz. After that every row is driven
+    // low, so any press pulls a column low, and the thread sleeps in
+    // poll(POLLPRI) on the column edges. On a backend without edge interrupts
+    // this degrades to a scan at IdleScanHz.
+    class MatrixKeypad final : public IStream {
+        private:
+            KeypadConfig config;
+            std::vector<MCAL::GPIO::GpioPin> rowPins;
+            std::vector<MCAL::GPIO::GpioPin> columnPins;
+            SpscQueue<KeyEvent> events;
+            std::thread scanner;
+            std::atomic<bool> stopping{false};
+
+            // Scan thread only
+            std::uint32_t rowLevels = 0xF;
+            std::uint16_t debounced = 0;
+            std::uint16_t pending = 0;              // keys whose raw state differs from debounced
+            std::uint16_t ghosted = 0;              // pending presses already counted as ghosts
+            std::array<std::chrono::nanoseconds, 16> changedAt{};
+
+            std::atomic<unsigned long long> scans{0};
+            std::atomic<unsigned long long> presses{0};
+            std::atomic<unsigned long long> ghosts{0};
+            std::atomic<long long> runningNs{0};
+            std::atomic<long long> cpuNs{0};
+            std::atomic<bool> idle{false};
+
+            // Reader side
+            std::atomic<unsigned long long> delivered{0};
+            std::atomic<long long> latencySumNs{0};
+            std::atomic<long long> latencyMaxNs{0};
+
+            std::uint16_t scanMatrix();
+            void debounce(std::uint16_t raw, std::chrono::nanoseconds now);
+            void waitForEdge(std::chrono::nanoseconds timeout);
+            void scanLoop();
+
+        public:
+            explicit MatrixKeypad(KeypadConfig cfg);
+
+            MatrixKeypad(const MatrixKeypad&) = delete;
+            MatrixKeypad& operator=(const MatrixKeypad&) = delete;
+
+            // Also restarts a stopped keypad; stats accumulate across runs
+            void start();
+            // Ends the input: a blocked reader gets EndOfInput
+            void stop();
+
+            // Next press or release; false once stopped and drained
+            bool readKey(KeyEvent & event);
+
+            // Presses of 0..9 as digits, other keys as NotADigit; releases are skipped
+            DigitResult tryReadDigit() noexcept override;
+
+            KeypadStats stats() const;
+
+            ~MatrixKeypad();
+    };
+
+}
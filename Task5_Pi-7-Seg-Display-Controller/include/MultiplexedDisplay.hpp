@@ -0,0 +1,97 @@
+#pragma once
+#include "FramedOStream.hpp"
+#include "Brightness.hpp"
+#include "gpio.hpp"
+#include "realtime.hpp"
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace HardwareIO{
+
+    struct MultiplexConfig {
+        std::vector<int> SegmentPins;       // a..g (+ dp), shared by every digit
+        std::vector<int> DigitPins;         // one enable line per digit, leftmost first
+        unsigned RefreshHz = 1000;          // digit slots per second (frame rate = RefreshHz / digits)
+        bool SegmentActiveLow = true;       // common anode segments
+        bool DigitActiveLow = false;
+        std::optional<MCAL::RealTimeConfig> RealTime;   // run the refresh thread real-time
+    };
+
+    struct RefreshStats {
+        double AchievedHz = 0;                      // slots per second while running
+        std::chrono::nanoseconds MeanJitter{0};     // slot start lateness vs schedule
+        std::chrono::nanoseconds MaxJitter{0};
+        unsigned long long Slots = 0;
+        bool Parked = false;                        // content needs no refresh right now
+    };
+
+    // 4-8 digit display sharing segment lines, with one enable pin per digit.
+    // A refresh thread lights one digit per slot: disable the previous digit,
+    // write only the segment lines that differ, enable the next one. Frames
+    // come from the FrameBuffer, so writers never stall on the scan and the
+    // scan never shows a half-written frame. When the content is blank or
+    // only one digit is lit there is nothing to multiplex, so that state is
+    // latched and the thread parks until a new frame is published.
+    //
+    // Brightness is set per digit or per segment (0..255). While any lit
+    // segment is below full brightness each slot is split into 8 binary-code
+    // modulation planes (see Brightness.hpp), i.e. 8 diff-based segment
+    // updates per slot.
+    //
+    // The planes are timed with Clock::SleepPrecise, which spins for the
+    // last PrecisionDelay::Slack() of every wait. A plane shorter than the
+    // slack is spun in full, so a dimmed display costs up to 8 x Slack() of
+    // CPU per slot whatever the level: at 1 kHz with a 60 us slack, up to
+    // 30% of a core. Lowering RefreshHz cuts that in proportion; content at
+    // full brightness skips the planes and pays nothing.
+    class MultiplexedDisplay : public FramedOStream {
+        private:
+            MultiplexConfig config;
+            std::vector<MCAL::GPIO::GpioPin> segmentPins;
+            std::vector<MCAL::GPIO::GpioPin> digitPins;
+            std::uint32_t segmentBits;
+
+            std::thread refresher;
+
+            // Written by any thread, picked up by the refresh thread
+            std::array<std::atomic<std::uint8_t>, MaxFrameDigits * 8> brightness;
+            std::atomic<unsigned> brightnessVersion{0};
+
+            // Refresh thread only
+            std::uint32_t drivenLevels = 0;
+            int enabledDigit = -1;
+            std::array<PlaneMasks, MaxFrameDigits> planes{};
+
+            std::atomic<unsigned long long> slots{0};
+            std::atomic<long long> activeNs{0};
+            std::atomic<long long> jitterSumNs{0};
+            std::atomic<long long> jitterMaxNs{0};
+
+            void refreshLoop();
+            void driveSlot(std::size_t digit, SegmentMask mask);
+            void setDigitEnabled(std::size_t digit, bool enabled);
+            bool buildAllPlanes(const Frame & frame);
+            void brightnessChanged();
+
+        public:
+            explicit MultiplexedDisplay(MultiplexConfig cfg);
+
+            MultiplexedDisplay(const MultiplexedDisplay&) = delete;
+            MultiplexedDisplay& operator=(const MultiplexedDisplay&) = delete;
+
+            void setBrightness(std::uint8_t level);
+            void setDigitBrightness(std::size_t digit, std::uint8_t level);
+            // segment: 0..7 = a..g, dp
+            void setSegmentBrightness(std::size_t digit, std::size_t segment, std::uint8_t level);
+
+            void start();
+            void stop();
+            RefreshStats stats() const;
+
+            ~MultiplexedDisplay();
+    };
+
+}
@@ -1,35 +1,125 @@
 #pragma once
 #include "IStream.hpp"
 #include "OStream.hpp"
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <memory>
-#include <map>
-#include <array>
 #include "gpio.hpp"
+#include "glyphs.hpp"
 
 namespace HardwareIO{
 
     constexpr int SevenSegmentPins[7] = {17,18,19,20,21,22,23};
 
-    class SevenSegment :  public IStream,  public OStream  {
+    // How a lit segment is driven
+    enum class Polarity {
+        CommonAnode,    // segment pin low = lit
+        CommonCathode   // segment pin high = lit
+    };
+
+    // A board describes its wiring at compile time:
+    //   SegmentPins  GPIO pin for segment a, b, ... g (and dp, if wired)
+    //   Wiring       Polarity of the digit
+    struct DefaultBoard {
+        static constexpr std::array<int, 7> SegmentPins = {SevenSegmentPins[0], SevenSegmentPins[1], SevenSegmentPins[2],
+                                                           SevenSegmentPins[3], SevenSegmentPins[4], SevenSegmentPins[5],
+                                                           SevenSegmentPins[6]};
+        static constexpr Polarity Wiring = Polarity::CommonAnode;
+    };
+
+    namespace detail{
+
+        // Board pins in ascending GPIO order: the order they are exported in
+        // and the bit order of the level words handed to GPIO_WritePins
+        template <typename Board>
+        constexpr auto sortedPins(){
+            auto pins = Board::SegmentPins;
+            for (std::size_t i = 1; i < pins.size(); i++)
+                for (std::size_t j = i; j > 0 && pins[j - 1] > pins[j]; j--) {
+                    int swap = pins[j]; pins[j] = pins[j - 1]; pins[j - 1] = swap;
+                }
+            return pins;
+        }
+
+        // Segment mask -> pin levels: every glyph permuted into pin order and
+        // inverted for common anode, once, at compile time
+        template <typename Board>
+        constexpr std::array<std::uint32_t, 256> makeLevelTable(){
+            constexpr auto pins = sortedPins<Board>();
+            std::array<std::uint32_t, 256> table{};
+            for (std::size_t mask = 0; mask < table.size(); mask++) {
+                std::uint32_t levels = 0;
+                for (std::size_t segment = 0; segment < Board::SegmentPins.size(); segment++) {
+                    bool lit = (mask >> segment) & 1u;
+                    bool high = (Board::Wiring == Polarity::CommonCathode) ? lit : !lit;
+                    std::size_t bit = 0;
+                    while (pins[bit] != Board::SegmentPins[segment]) bit++;
+                    levels |= static_cast<std::uint32_t>(high) << bit;
+                }
+                table[mask] = levels;
+            }
+            return table;
+        }
+
+    }
+
+    // One 7-segment digit wired as Board says. Each write is one table load
+    // plus an XOR against the levels already on the pins; only pins that
+    // change are written, and nothing branches on the wiring at runtime.
+    // Boards are independent types, so several can live in one binary.
+    template <typename Board>
+    class BasicSevenSegment final :  public IStream,  public OStream  {
+        static_assert(Board::SegmentPins.size() == 7 || Board::SegmentPins.size() == 8,
+                      "a board wires segments a..g and optionally dp");
+        static_assert(Board::SegmentPins.size() <= 32, "pin levels fit one word");
+
+        public:
+            static constexpr std::array<std::uint32_t, 256> Levels = detail::makeLevelTable<Board>();
+
         private:
 
-            std::array<int, 7> arr;
-            std::map<int, std::array<int,7> >representation;
-            void init_map();
+            std::uint32_t current = Levels[BlankGlyph];     // levels currently on the pins
             std::vector<MCAL::GPIO::GpioPin> Pins;
         public:
 
-        SevenSegment();
-       
+        BasicSevenSegment() {
+            constexpr auto pins = detail::sortedPins<Board>();
+            Pins.reserve(pins.size());
+            for (std::size_t i = 0; i < pins.size(); i++)
+                Pins.emplace_back(pins[i], MCAL::GPIO::PinOUT, static_cast<int>((current >> i) & 1u));
+        }
 
-        SevenSegment(const SevenSegment&) = delete;
-        SevenSegment& operator=(const SevenSegment&) = delete;
+        BasicSevenSegment(const BasicSevenSegment&) = delete;
+        BasicSevenSegment& operator=(const BasicSevenSegment&) = delete;
 
-        SevenSegment(SevenSegment&&) = default;
-        SevenSegment& operator=(SevenSegment&&) = default;
+        BasicSevenSegment(BasicSevenSegment&&) = default;
+        BasicSevenSegment& operator=(BasicSevenSegment&&) = default;
 
-        void writeDigit(int x) override ;
+        // False if any segment's value file could not be opened (pins not
+        // exported, or no permission); writes would then be lost
+        bool pinsOpen() {
+            for (auto & pin : Pins)
+                if (pin.ValueFd() < 0) return false;
+            return true;
+        }
+
+        // 0..15 shows a hex digit, anything else blanks the display
+        void writeDigit(int x) override {
+            writeMask(digitGlyph(x));
+        }
+
+        // Show an arbitrary glyph; only segments that differ from the
+        // current one are written (dp is dropped unless the board wires it)
+        void writeMask(SegmentMask mask) {
+            std::uint32_t levels = Levels[mask];
+            MCAL::GPIO::GPIO_WritePins(Pins, levels, levels ^ current);
+            current = levels;
+        }
 
     };
-}
\ No newline at end of file
+
+    extern template class BasicSevenSegment<DefaultBoard>;
+
+    using SevenSegment = BasicSevenSegment<DefaultBoard>;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "FramedOStream.hpp"
+#include "gpio.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace HardwareIO{
+
+    struct ShiftRegisterConfig {
+        int DataPin;                        // SER (pin 14)
+        int ClockPin;                       // SRCLK (pin 11)
+        int LatchPin;                       // RCLK (pin 12)
+        std::size_t Digits = 4;             // one 74HC595 per digit, QA..QG = a..g, QH = dp
+        bool SegmentActiveLow = true;       // common anode segments
+    };
+
+    struct ShiftRegisterStats {
+        unsigned long long Frames = 0;
+        double DigitsPerSecond = 0;         // digits latched per second of shifting time
+        double GpioWritesPerFrame = 0;
+    };
+
+    // Seven-segment digits behind a chain of 74HC595 shift registers, driven
+    // over three GPIO lines. For each published frame the driver thread
+    // precomputes the serial bit stream once, then clocks it out (the data
+    // line is only written when the next bit differs) and pulses the latch,
+    // so every digit changes at the same instant.
+    class ShiftRegisterDisplay : public FramedOStream {
+        private:
+            static constexpr std::size_t MaxBits = MaxFrameDigits * 8;
+
+            ShiftRegisterConfig config;
+            std::vector<MCAL::GPIO::GpioPin> pins;  // data, clock, latch
+            int dataLevel = MCAL::GPIO::PinLow;
+            std::thread driver;
+
+            std::atomic<unsigned long long> frameCount{0};
+            std::atomic<unsigned long long> gpioWrites{0};
+            std::atomic<long long> shiftNs{0};
+
+            std::size_t buildBitStream(const Frame & frame, std::uint8_t (&bits)[MaxBits]) const;
+            void shiftOut(const std::uint8_t (&bits)[MaxBits], std::size_t count);
+            void driveLoop();
+
+        public:
+            explicit ShiftRegisterDisplay(const ShiftRegisterConfig & cfg);
+
+            ShiftRegisterDisplay(const ShiftRegisterDisplay&) = delete;
+            ShiftRegisterDisplay& operator=(const ShiftRegisterDisplay&) = delete;
+
+            void start();
+            void stop();
+            ShiftRegisterStats stats() const;
+
+            ~ShiftRegisterDisplay();
+    };
+
+}
@@ -0,0 +1,197 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace HardwareIO{
+
+    // What push() does when the queue is full
+    enum class Backpressure {
+        Block,          // wait for the consumer
+        DropOldest,     // overwrite the oldest queued item
+        DropNewest      // discard the item being pushed
+    };
+
+    struct QueueStats {
+        std::size_t Capacity = 0;
+        std::size_t Occupancy = 0;          // items queued right now
+        std::size_t HighWater = 0;          // most items ever queued at once
+        unsigned long long Pushed = 0;         // accepted, including ones later evicted
+        unsigned long long Popped = 0;
+        unsigned long long Dropped = 0;
+    };
+
+    // Bounded lock-free single-producer/single-consumer ring.
+    //
+    // head (next item to pop) and tail (next free slot) are monotonically
+    // increasing counters. Items live in atomic words, so DropOldest can let
+    // the producer advance head with a CAS: a consumer that copied an item the
+    // producer was overwriting loses the same CAS and simply retries. A
+    // waiting side spins briefly and then parks on a condition variable that
+    // the other side only touches when it sees someone parked.
+    template <typename T>
+    class SpscQueue {
+        static_assert(std::is_trivially_copyable<T>::value, "SpscQueue items are copied word by word");
+
+        private:
+            static constexpr std::size_t Words = (sizeof(T) + 7) / 8;
+            using Slot = std::array<std::atomic<std::uint64_t>, Words>;
+            static constexpr int SpinsBeforePark = 256;
+
+            std::vector<Slot> slots;
+            std::size_t mask;
+            Backpressure policy;
+
+            alignas(64) std::atomic<std::uint64_t> head{0};
+            alignas(64) std::atomic<std::uint64_t> tail{0};
+
+            alignas(64) std::atomic<unsigned long long> evicted{0};     // DropOldest
+            std::atomic<unsigned long long> rejected{0};                // DropNewest
+            std::atomic<std::size_t> highWater{0};
+            std::atomic<bool> closed{false};
+
+            std::mutex parkMutex;
+            std::condition_variable wake;
+            std::atomic<int> parked{0};
+
+            static void store(Slot & slot, const T & item) {
+                std::uint64_t words[Words] = {};
+                std::memcpy(words, &item, sizeof(T));
+                for (std::size_t i = 0; i < Words; i++) slot[i].store(words[i], std::memory_order_relaxed);
+            }
+
+            static T load(const Slot & slot) {
+                std::uint64_t words[Words];
+                for (std::size_t i = 0; i < Words; i++) words[i] = slot[i].load(std::memory_order_relaxed);
+                T item;
+                std::memcpy(&item, words, sizeof(T));
+                return item;
+            }
+
+            void notify() {
+                // Pairs with the fence in waitUntil: either the waiter sees
+                // our update in its predicate or we see it parked
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (parked.load() > 0) {
+                    std::lock_guard<std::mutex> lock(parkMutex);
+                    wake.notify_all();
+                }
+            }
+
+            template <typename Ready>
+            void waitUntil(Ready ready) {
+                for (int spin = 0; spin < SpinsBeforePark; spin++) {
+                    if (ready()) return;
+                    std::this_thread::yield();
+                }
+                std::unique_lock<std::mutex> lock(parkMutex);
+                parked++;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wake.wait(lock, ready);
+                parked--;
+            }
+
+        public:
+            // capacity is rounded up to a power of two
+            explicit SpscQueue(std::size_t capacity, Backpressure backpressure = Backpressure::Block)
+                : policy(backpressure)
+            {
+                if (capacity == 0) throw std::invalid_argument("Queue capacity must be positive");
+                std::size_t size = 1;
+                while (size < capacity) size <<= 1;
+                slots = std::vector<Slot>(size);
+                mask = size - 1;
+            }
+
+            SpscQueue(const SpscQueue&) = delete;
+            SpscQueue& operator=(const SpscQueue&) = delete;
+
+            // Producer. false if the item was dropped (DropNewest) or the queue is closed.
+            bool push(const T & item) {
+                const std::uint64_t t = tail.load(std::memory_order_relaxed);
+                const std::size_t capacity = slots.size();
+
+                if (t - head.load(std::memory_order_acquire) >= capacity) {
+                    if (policy == Backpressure::DropNewest) {
+                        rejected.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    if (policy == Backpressure::Block) {
+                        waitUntil([&] { return closed.load() || t - head.load() < capacity; });
+                        if (closed.load()) return false;
+                    } else {
+                        std::uint64_t h = head.load(std::memory_order_acquire);
+                        while (t - h >= capacity) {
+                            if (head.compare_exchange_weak(h, h + 1, std::memory_order_acq_rel)) {
+                                evicted.fetch_add(1, std::memory_order_relaxed);
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                store(slots[t & mask], item);
+                tail.store(t + 1, std::memory_order_release);
+
+                std::size_t occupancy = static_cast<std::size_t>(t + 1 - head.load(std::memory_order_relaxed));
+                if (occupancy > highWater.load(std::memory_order_relaxed)) highWater.store(occupancy, std::memory_order_relaxed);
+                notify();
+                return true;
+            }
+
+            // Consumer, non-blocking
+            bool tryPop(T & item) {
+                std::uint64_t h = head.load(std::memory_order_acquire);
+                while (h != tail.load(std::memory_order_acquire)) {
+                    T copy = load(slots[h & mask]);
+                    if (head.compare_exchange_strong(h, h + 1, std::memory_order_acq_rel)) {
+                        item = copy;
+                        notify();
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Consumer, blocking. false once the queue is closed and drained.
+            bool pop(T & item) {
+                while (true) {
+                    if (tryPop(item)) return true;
+                    if (closed.load()) return tryPop(item);
+                    waitUntil([&] { return closed.load() || head.load() != tail.load(); });
+                }
+            }
+
+            // No more pushes; wakes both sides
+            void close() {
+                closed = true;
+                std::lock_guard<std::mutex> lock(parkMutex);
+                wake.notify_all();
+            }
+
+            // Undo close() for another run. Only while neither side is in push or pop.
+            void reopen() { closed = false; }
+
+            QueueStats stats() const {
+                QueueStats result;
+                std::uint64_t t = tail.load();
+                std::uint64_t h = head.load();
+                result.Capacity = slots.size();
+                result.Occupancy = static_cast<std::size_t>(t >= h ? t - h : 0);
+                result.HighWater = highWater.load();
+                unsigned long long lost = evicted.load();
+                result.Dropped = lost + rejected.load();
+                result.Pushed = t;
+                result.Popped = h - lost;
+                return result;
+            }
+    };
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "IStream.hpp"
+#include "OStream.hpp"
+#include <cstddef>
+#include <variant>
+
+namespace HardwareIO{
+
+    // Statically dispatched counterpart of the IStream/OStream loop in main.
+    //
+    // pumpDigits is instantiated per concrete device pair, so tryReadDigit and
+    // writeDigit are direct calls on final classes (inlinable where the body is
+    // visible) instead of virtual calls through the Stream diamond. Runtime
+    // device selection still works: put the chosen devices in a DeviceRef and
+    // the variant is visited once, outside the loop.
+
+    template <typename... Devices>
+    using DeviceRef = std::variant<Devices*...>;
+
+    // Read until end of input, writing each digit. after(result) runs after
+    // every read (digit or error); returning false stops the loop. Returns the
+    // number of digits written.
+    template <typename Input, typename Output, typename After>
+    std::size_t pumpDigits(Input & input, Output & output, After && after) {
+        std::size_t written = 0;
+        while (true) {
+            DigitResult result = input.tryReadDigit();
+            if (result.error == InputError::EndOfInput) break;
+            if (result) {
+                output.writeDigit(result.value);
+                written++;
+            }
+            if (!after(result)) break;
+        }
+        return written;
+    }
+
+    template <typename Input, typename Output>
+    std::size_t pumpDigits(Input & input, Output & output) {
+        return pumpDigits(input, output, [](const DigitResult &) { return true; });
+    }
+
+    template <typename... Inputs, typename... Outputs, typename After>
+    std::size_t pumpDigits(const DeviceRef<Inputs...> & input, const DeviceRef<Outputs...> & output, After && after) {
+        return std::visit([&](auto * in, auto * out) { return pumpDigits(*in, *out, after); }, input, output);
+    }
+
+    template <typename... Inputs, typename... Outputs>
+    std::size_t pumpDigits(const DeviceRef<Inputs...> & input, const DeviceRef<Outputs...> & output) {
+        return pumpDigits(input, output, [](const DigitResult &) { return true; });
+    }
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "FramedOStream.hpp"
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace HardwareIO{
+
+    // Seven-segment art in an ANSI terminal, drawn from the same segment
+    // masks the hardware uses:
+    //
+    //     _       _
+    //    |_|  |  |_ .
+    //    |_|  |   _|
+    //
+    // A driver thread renders published frames at up to MaxFps. The first
+    // frame is printed in full; after that only the cells that changed are
+    // sent, each run as one cursor move plus its characters, so redraws stay
+    // cheap over SSH; when that would take more bytes than the art itself,
+    // as when every digit changes, the art is redrawn in full instead. The
+    // art occupies the 3 lines above the cursor.
+    class TerminalDisplay : public FramedOStream {
+        private:
+            static constexpr std::size_t Rows = 3;
+            static constexpr std::size_t CellsPerDigit = 4;
+            static constexpr std::size_t MaxColumns = MaxFrameDigits * CellsPerDigit;
+            using Cells = std::array<std::array<char, MaxColumns>, Rows>;
+
+            std::ostream & out;
+            unsigned maxFps;
+            Cells shown{};
+            bool drawn = false;
+            std::string pending;        // escape sequences for one frame, capacity reused
+            std::thread renderer;
+
+            std::atomic<unsigned long long> renderedFrames{0};
+            std::atomic<unsigned long long> emittedBytes{0};
+            std::atomic<unsigned long long> fullFrameBytes{0};
+
+            Cells layout(const Frame & frame) const;
+            void renderLoop();
+
+        public:
+            explicit TerminalDisplay(std::size_t digits, unsigned fps = 60, std::ostream & stream = std::cout);
+
+            TerminalDisplay(const TerminalDisplay&) = delete;
+            TerminalDisplay& operator=(const TerminalDisplay&) = delete;
+
+            // Draw the latest frame now (what the thread does per frame)
+            void render();
+
+            void start();
+            void stop();
+            unsigned long long frameCount() const { return renderedFrames.load(std::memory_order_relaxed); }
+            unsigned long long byteCount() const { return emittedBytes.load(std::memory_order_relaxed); }
+            // Mean bytes of the incremental redraws after the first, full frame
+            double bytesPerUpdate() const;
+
+            ~TerminalDisplay();
+    };
+
+}
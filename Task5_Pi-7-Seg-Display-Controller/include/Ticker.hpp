@@ -0,0 +1,70 @@
+#pragma once
+#include "FramedOStream.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace HardwareIO{
+
+    enum class TickerEffect {
+        Scroll,     // text enters on the right and leaves on the left
+        Blink       // text and a blank frame alternate
+    };
+
+    // Precomputed frames for one message. All glyph lookup, decimal-point
+    // merging and windowing happens once in load(); playing a frame is a
+    // copy of an already built Frame.
+    class Ticker {
+        private:
+            std::size_t digits;
+            std::vector<Frame> frames;
+
+        public:
+            explicit Ticker(std::size_t digitCount);
+
+            void load(const char * text, TickerEffect effect = TickerEffect::Scroll);
+            void load(long long number, TickerEffect effect = TickerEffect::Scroll);
+
+            std::size_t frameCount() const { return frames.size(); }
+            const Frame & frame(std::size_t index) const { return frames[index]; }
+    };
+
+    // Plays any number of (ticker, display) pairs at a fixed frame rate from
+    // one thread. Each tick publishes one precomputed frame per display and
+    // allocates nothing. The player is the only writer of its displays.
+    class TickerPlayer {
+        private:
+            struct Track {
+                const Ticker * ticker;
+                FramedOStream * display;
+                std::size_t position;
+            };
+
+            unsigned framesPerSecond;
+            std::vector<Track> tracks;
+            std::thread player;
+            std::atomic<bool> stopping{false};
+            std::atomic<unsigned long long> ticks{0};
+
+            void playLoop();
+
+        public:
+            explicit TickerPlayer(unsigned fps);
+
+            TickerPlayer(const TickerPlayer&) = delete;
+            TickerPlayer& operator=(const TickerPlayer&) = delete;
+
+            // Register before start(); the ticker and display must outlive the player
+            void add(const Ticker & ticker, FramedOStream & display);
+
+            // Advance every track by one frame (what the thread does per tick)
+            void tick();
+
+            void start();
+            void stop();
+            unsigned long long tickCount() const { return ticks.load(std::memory_order_relaxed); }
+
+            ~TickerPlayer();
+    };
+
+}
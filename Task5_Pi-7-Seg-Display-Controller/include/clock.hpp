@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <atomic>
+
+namespace MCAL {
+
+    // Time source for every delay in the library. GpioPin and the display
+    // drivers never sleep directly, so tests and benchmarks can swap in a
+    // VirtualClock and run timing logic instantly and reproducibly.
+    class Clock {
+    public:
+        virtual ~Clock() = default;
+
+        // Monotonic time since an arbitrary epoch
+        virtual std::chrono::nanoseconds Now() = 0;
+        virtual void SleepFor(std::chrono::nanoseconds duration) = 0;
+        // For deadlines that must be hit to the microsecond; may spin, so
+        // only for short waits such as display planes. Defaults to SleepFor.
+        virtual void SleepPrecise(std::chrono::nanoseconds duration) { SleepFor(duration); }
+    };
+
+    // steady_clock for Now(); SleepFor is std::this_thread::sleep_for and
+    // SleepPrecise the calibrated PrecisionDelay
+    class RealClock : public Clock {
+    public:
+        std::chrono::nanoseconds Now() override;
+        void SleepFor(std::chrono::nanoseconds duration) override;
+        void SleepPrecise(std::chrono::nanoseconds duration) override;
+    };
+
+    // Time only moves when someone sleeps or calls Advance, so a 6 s toggle
+    // completes immediately and always reports exactly 6 s elapsed.
+    class VirtualClock : public Clock {
+    private:
+        std::atomic<long long> nowNs{0};
+
+    public:
+        std::chrono::nanoseconds Now() override;
+        void SleepFor(std::chrono::nanoseconds duration) override;
+        void Advance(std::chrono::nanoseconds duration);
+    };
+
+    // Process-wide clock used by the library (a RealClock unless replaced).
+    Clock & ActiveClock();
+    // Install clock (nullptr restores the real clock). The caller keeps ownership.
+    void SetActiveClock(Clock * clock);
+
+}
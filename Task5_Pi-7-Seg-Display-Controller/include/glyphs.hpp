@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace HardwareIO{
+
+    // One bit per segment, 1 = lit:  bit0..bit6 = a..g, bit7 = decimal point
+    //
+    //      a
+    //    f   b
+    //      g
+    //    e   c
+    //      d   dp
+    using SegmentMask = std::uint8_t;
+
+    constexpr SegmentMask SegA = 1 << 0;
+    constexpr SegmentMask SegB = 1 << 1;
+    constexpr SegmentMask SegC = 1 << 2;
+    constexpr SegmentMask SegD = 1 << 3;
+    constexpr SegmentMask SegE = 1 << 4;
+    constexpr SegmentMask SegF = 1 << 5;
+    constexpr SegmentMask SegG = 1 << 6;
+    constexpr SegmentMask SegDP = 1 << 7;
+
+    constexpr SegmentMask BlankGlyph = 0;
+
+    namespace detail{
+
+        constexpr std::array<SegmentMask, 128> makeGlyphTable(){
+            std::array<SegmentMask, 128> table{};
+            const SegmentMask digits[16] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
+                                            0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+            for (int i = 0; i < 10; i++) table['0' + i] = digits[i];
+            for (int i = 0; i < 6; i++) {
+                table['A' + i] = digits[10 + i];
+                table['a' + i] = digits[10 + i];
+            }
+            table['c'] = 0x58;
+            table['G'] = table['g'] = 0x3D;
+            table['H'] = 0x76;  table['h'] = 0x74;
+            table['I'] = 0x06;  table['i'] = 0x04;
+            table['J'] = table['j'] = 0x1E;
+            table['L'] = 0x38;  table['l'] = 0x30;
+            table['N'] = table['n'] = 0x54;
+            table['O'] = 0x3F;  table['o'] = 0x5C;
+            table['P'] = table['p'] = 0x73;
+            table['Q'] = table['q'] = 0x67;
+            table['R'] = table['r'] = 0x50;
+            table['S'] = table['s'] = 0x6D;
+            table['T'] = table['t'] = 0x78;
+            table['U'] = 0x3E;  table['u'] = 0x1C;
+            table['Y'] = table['y'] = 0x6E;
+            table['-'] = 0x40;
+            table['_'] = 0x08;
+            table['='] = 0x48;
+            table['"'] = 0x22;
+            table['\''] = 0x02;
+            table['.'] = SegDP;
+            return table;
+        }
+
+    }
+
+    // ASCII -> segments; characters a 7-segment digit can't show are blank
+    constexpr std::array<SegmentMask, 128> GlyphTable = detail::makeGlyphTable();
+
+    constexpr SegmentMask glyphFor(char c){
+        return static_cast<unsigned char>(c) < GlyphTable.size() ? GlyphTable[static_cast<unsigned char>(c)] : BlankGlyph;
+    }
+
+    // 0..15 -> hex digit, anything else -> blank
+    constexpr SegmentMask digitGlyph(int x){
+        return (x >= 0 && x < 16) ? glyphFor("0123456789ABCDEF"[x]) : BlankGlyph;
+    }
+
+    static_assert(digitGlyph(8) == 0x7F, "8 lights a..g");
+    static_assert(digitGlyph(16) == BlankGlyph, "out of range digits are blank");
+
+}
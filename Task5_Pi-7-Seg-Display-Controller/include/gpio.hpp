@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 #include <initializer_list>
+#include <cstdint>
+#include <atomic>
 
 namespace MCAL {
     namespace GPIO {
@@ -16,24 +18,43 @@ namespace MCAL {
         constexpr int PinHigh = 1;
         constexpr int PinLow = 0;
 
+        // Input edges that wake poll(POLLPRI) on the value descriptor
+        constexpr int EdgeNone = 0;
+        constexpr int EdgeRising = 1;
+        constexpr int EdgeFalling = 2;
+        constexpr int EdgeBoth = 3;
+
         struct PinsConfig {
             int PinNumber;
             int PinState;
             int PinDir;
         };
 
+        // Where the sysfs GPIO tree lives ("/sys/class/gpio" by default).
+        // Set it before any pin is constructed; it is not changed under live pins.
+        void GPIO_SetSysfsRoot(const std::string & root);
+        const std::string & GPIO_SysfsRoot();
+
+        // Thread safety:
+        //  - Different GpioPin objects may be used from different threads freely.
+        //  - One GpioPin may be shared between threads for SetPinVal, Toggle_Pin,
+        //    SetPinDir and GetPinValue. Each sysfs access is a single pread/pwrite
+        //    on a descriptor that is published once, so no call observes a torn or
+        //    closed descriptor. Concurrent writers race only on the level: the last
+        //    pwrite to reach the kernel wins, and PinState records the last request.
+        //  - Construction, moves and destruction need exclusive access, as for any
+        //    other object.
         class GpioPin {
         private:
-            int fd;
+            std::atomic<int> fd;        // cached "value" descriptor, opened on first access
             int PinNumber;
-            int PinDirection;
-            int PinState;
-
-            const std::string ExportPATH = "/sys/class/gpio/export";
-            const std::string UnexportPATH = "/sys/class/gpio/unexport";
+            std::atomic<int> PinDirection;
+            std::atomic<int> PinState;
 
             int writeToFile(const std::string& path, const std::string& value);
             std::string readFromFile(const std::string& path);
+            int openValueFd() noexcept;
+            void closeValueFd() noexcept;
             void ActivePin();
             void DeactivePin();
 
@@ -52,10 +73,19 @@ namespace MCAL {
 
             // Methods
             void SetPinDir(int dir);
+            void SetPinEdge(int edge);
             void SetPinVal(int val);
             void Toggle_Pin();
             int GetPinValue();
 
+            // Non-throwing, allocation-free read: stores 0/1 in value and
+            // returns 0, or returns a negative errno and leaves value untouched.
+            int GetPinValue(int & value) noexcept;
+
+            // The cached value descriptor, for poll(POLLPRI) after SetPinEdge.
+            // Owned by the pin; -1 if it can't be opened.
+            int ValueFd() noexcept { return openValueFd(); }
+
             // Destructor
             ~GpioPin();
         };
@@ -66,5 +96,14 @@ namespace MCAL {
         // Initialize multiple pins with custom configs
         std::vector<GpioPin> GPIO_InitPins(std::initializer_list<PinsConfig> configs);
 
+        // Read up to 32 pins in one call: bit i of mask is the value of pins[i].
+        // Returns 0, -E2BIG for more than 32 pins (nothing is read), or the
+        // first negative errno (mask holds the pins read so far).
+        int GPIO_Snapshot(std::vector<GpioPin> & pins, std::uint32_t & mask) noexcept;
+
+        // Bulk write: for every bit set in changed, drive pins[i] to bit i of
+        // levels. Pins outside changed are not touched (no syscall).
+        void GPIO_WritePins(std::vector<GpioPin> & pins, std::uint32_t levels, std::uint32_t changed);
+
     }
 }
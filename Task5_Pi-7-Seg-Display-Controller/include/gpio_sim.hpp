@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+
+namespace MCAL {
+    namespace GPIO {
+
+        // Simulator backend: a scratch directory laid out like /sys/class/gpio
+        // (export, unexport and gpioN/{direction,value,edge} as regular files).
+        // While alive it is installed as the sysfs root, so GpioPin runs the
+        // same code paths without hardware or root privileges.
+        class SysfsSimulator {
+        private:
+            std::string root;
+            std::string previousRoot;
+            int firstPin;
+            int pinCount;
+
+        public:
+            explicit SysfsSimulator(int firstPin = 0, int pinCount = 32);
+
+            SysfsSimulator(const SysfsSimulator &) = delete;
+            SysfsSimulator & operator=(const SysfsSimulator &) = delete;
+
+            const std::string & Root() const { return root; }
+
+            ~SysfsSimulator();
+        };
+
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MCAL {
+    namespace GPIO {
+
+        // What a trace event records
+        enum class TraceOp : std::uint8_t {
+            None = 0,       // slot claimed but never filled
+            Export,
+            Unexport,
+            Direction,      // value: PinIN / PinOUT
+            Write,          // value: level written
+            Read,           // value: level read
+            Edge            // value: EdgeNone .. EdgeBoth
+        };
+
+        struct TraceEvent {
+            std::chrono::nanoseconds Time;      // since recording started
+            TraceOp Op;
+            int Pin;                            // GpioPin number (GPIO_BASE not added)
+            int Value;
+        };
+
+        struct TraceHeader;
+
+        // Trace file: a 64-byte header followed by a ring of 8-byte records.
+        //
+        //   bits 63..16  time since start, ns (48 bits, ~78 hours)
+        //   bits 15..12  TraceOp
+        //   bits 11..10  value
+        //   bits  9..0   pin (0..1023)
+        //
+        // The file is mmap'ed, so recording is a fetch_add on the header's event
+        // counter plus one 8-byte store, from any thread, with no syscalls; the
+        // kernel writes the pages back, and a crashed process still leaves the
+        // last Capacity events on disk. Once full, the oldest events are
+        // overwritten.
+        class TraceRecorder {
+        private:
+            TraceHeader * header = nullptr;
+            std::atomic<std::uint64_t> * records = nullptr;
+            std::size_t mappedSize = 0;
+            std::uint64_t capacity = 0;
+            std::chrono::nanoseconds start{0};
+
+        public:
+            // Creates (or truncates) path; throws std::runtime_error on failure
+            explicit TraceRecorder(const std::string & path, std::size_t capacity = 1 << 20);
+
+            TraceRecorder(const TraceRecorder &) = delete;
+            TraceRecorder & operator=(const TraceRecorder &) = delete;
+
+            void Record(TraceOp op, int pin, int value) noexcept;
+            std::uint64_t EventCount() const noexcept;
+
+            ~TraceRecorder();
+        };
+
+        // Install recorder for every GpioPin in the process (nullptr stops
+        // recording). The caller keeps ownership and must uninstall it, with no
+        // pin operations in flight, before destroying it.
+        void GPIO_SetTraceRecorder(TraceRecorder * recorder);
+        TraceRecorder * GPIO_TraceRecorder();
+
+        // Events of a trace file, oldest first. Throws std::runtime_error if the
+        // file is missing or not a trace.
+        std::vector<TraceEvent> GPIO_LoadTrace(const std::string & path);
+
+        enum class ReplayTiming {
+            Original,           // wait for each event's recorded offset
+            AsFastAsPossible    // back to back (export settle delays skipped)
+        };
+
+        struct ReplayStats {
+            std::size_t Events = 0;
+            std::size_t ReadMismatches = 0;     // read level differs from the recording
+            std::chrono::nanoseconds Elapsed{0};
+            std::chrono::nanoseconds MaxLag{0}; // Original timing: worst lateness
+        };
+
+        // Drive the current backend (real sysfs or a SysfsSimulator) with the
+        // events: pins are exported, configured, written and read as recorded.
+        // A pin whose export fell out of the ring is exported on first use, and
+        // pins still exported at the end are released.
+        ReplayStats GPIO_ReplayTrace(const std::vector<TraceEvent> & events, ReplayTiming timing);
+
+    }
+}
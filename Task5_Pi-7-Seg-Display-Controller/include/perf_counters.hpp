@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace MCAL {
+
+    enum class PerfEvent {
+        Cycles,
+        Instructions,
+        CacheMisses,
+        BranchMisses,
+        ContextSwitches
+    };
+
+    constexpr std::size_t PerfEventCount = 5;
+
+    const char * PerfEventName(PerfEvent event);
+
+    struct PerfReading {
+        std::array<double, PerfEventCount> Totals{};   // scaled if the kernel multiplexed the counter
+        std::array<bool, PerfEventCount> Valid{};      // false: counter unavailable
+        std::uint64_t Operations = 1;
+
+        bool Has(PerfEvent event) const { return Valid[static_cast<std::size_t>(event)]; }
+        double Total(PerfEvent event) const { return Totals[static_cast<std::size_t>(event)]; }
+        double PerOperation(PerfEvent event) const { return Operations ? Total(event) / Operations : 0; }
+    };
+
+    // "cycles 812.3  instructions 1204 ... /op", n/a for missing counters
+    std::ostream & operator<<(std::ostream & out, const PerfReading & reading);
+
+    // Hardware and software counters for the calling thread (and threads it
+    // starts while counting) via perf_event_open, one descriptor per event so
+    // each can fail on its own. Containers, VMs and perf_event_paranoid often
+    // hide some or all of them: those are reported as unavailable and the
+    // region still runs. Kernel time is counted when permitted, which is
+    // where the sysfs backend spends most of its time. Context switches need
+    // kernel counting; without it they come from getrusage for the whole
+    // process, so they are always available.
+    //
+    //   PerfCounters counters;
+    //   counters.Start();
+    //   for (int i = 0; i < n; i++) pin.SetPinVal(i & 1);
+    //   std::cout << counters.Stop(n) << std::endl;
+    class PerfCounters {
+    private:
+        std::array<int, PerfEventCount> fds;
+        bool kernelIncluded = false;
+        long long switchesAtStart = 0;
+
+    public:
+        PerfCounters();
+
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters & operator=(const PerfCounters &) = delete;
+
+        bool Available(PerfEvent event) const;
+        // Any of cycles, instructions, cache misses, branch misses
+        bool HardwareAvailable() const;
+        // False if any available counter had to fall back to user space only
+        bool KernelIncluded() const { return kernelIncluded; }
+
+        // Zero and enable the counters
+        void Start();
+        // Disable them and read the totals since Start()
+        PerfReading Stop(std::uint64_t operations = 1);
+
+        template <typename Region>
+        PerfReading Measure(std::uint64_t operations, Region && region) {
+            Start();
+            region();
+            return Stop(operations);
+        }
+
+        ~PerfCounters();
+    };
+
+}
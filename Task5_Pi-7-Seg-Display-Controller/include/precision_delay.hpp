@@ -0,0 +1,30 @@
+#pragma once
+#include <chrono>
+
+namespace MCAL {
+
+    // Hybrid sleep/spin delay for microsecond deadlines. It sleeps with
+    // clock_nanosleep until `Slack()` before the deadline, then spins on
+    // CLOCK_MONOTONIC_RAW for the rest. Slack is the measured oversleep of
+    // clock_nanosleep on this machine, so short delays neither oversleep by
+    // the scheduler's wake-up latency nor burn a core for their full length.
+    class PrecisionDelay {
+    private:
+        std::chrono::nanoseconds slack{0};
+
+    public:
+        // Calibrated once, on first use
+        static PrecisionDelay & Instance();
+
+        // Re-measure the clock_nanosleep oversleep (p99 of `samples` sleeps)
+        void Calibrate(int samples = 200);
+        std::chrono::nanoseconds Slack() const { return slack; }
+
+        void SleepFor(std::chrono::nanoseconds duration) const;
+        // Deadline on CLOCK_MONOTONIC_RAW, as returned by Now()
+        void SleepUntil(std::chrono::nanoseconds deadline) const;
+
+        static std::chrono::nanoseconds Now();
+    };
+
+}
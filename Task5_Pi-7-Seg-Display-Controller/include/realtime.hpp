@@ -0,0 +1,58 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <sched.h>
+
+namespace MCAL {
+
+    struct RealTimeConfig {
+        int Priority = 80;                  // SCHED_FIFO priority (1..99)
+        int Cpu = -1;                       // CPU to pin the thread to, -1 = keep affinity
+        bool LockMemory = true;             // mlockall(MCL_CURRENT | MCL_FUTURE)
+        std::size_t PrefaultStack = 64 * 1024;  // bytes of stack touched up front
+    };
+
+    struct WakeupLatency {
+        std::chrono::nanoseconds Min{0};
+        std::chrono::nanoseconds Avg{0};
+        std::chrono::nanoseconds P99{0};
+        std::chrono::nanoseconds Max{0};
+        int Samples = 0;
+    };
+
+    // Opt-in real-time mode for the calling thread, for timing-critical loops
+    // (bit-banged protocols, PWM, display refresh). The constructor applies
+    // SCHED_FIFO, CPU affinity, mlockall and a stack pre-fault; the destructor
+    // restores the previous policy, priority, affinity and memory locking.
+    // Steps that fail (usually EPERM without CAP_SYS_NICE) are skipped with a
+    // warning and reported by the accessors, so the loop still runs.
+    // Memory locking is process-wide: nest scopes rather than overlap them
+    // across threads if more than one thread needs it.
+    class RealTimeScope {
+    private:
+        int previousPolicy;
+        sched_param previousParam;
+        cpu_set_t previousAffinity;
+        bool schedulingApplied = false;
+        bool affinityApplied = false;
+        bool memoryLocked = false;
+
+    public:
+        explicit RealTimeScope(const RealTimeConfig & config = RealTimeConfig{});
+
+        RealTimeScope(const RealTimeScope &) = delete;
+        RealTimeScope & operator=(const RealTimeScope &) = delete;
+
+        bool SchedulingApplied() const { return schedulingApplied; }
+        bool AffinityApplied() const { return affinityApplied; }
+        bool MemoryLocked() const { return memoryLocked; }
+
+        ~RealTimeScope();
+    };
+
+    // Sleep `samples` times on an absolute period with clock_nanosleep and
+    // report how late each wake-up was. Run it inside and outside a
+    // RealTimeScope to quantify what the real-time mode buys.
+    WakeupLatency MeasureWakeupLatency(std::chrono::microseconds period, int samples);
+
+}
@@ -4,13 +4,45 @@
 #include "OStream.hpp"
 #include "IStream.hpp"
 #include <iostream>
+#include <array>
+#include <chrono>
 
 namespace HardwareIO {
-    class Terminal: public IStream , public OStream{
+
+    // When Terminal hands its output to the stream.
+    //  - Unbuffered (default): one line and one flush per digit, as before.
+    //  - Buffered: digits are formatted into a reusable buffer that is flushed
+    //    when it holds MaxBytes, when a write finds the oldest buffered digit
+    //    older than MaxDelay, on flush(), and on destruction.
+    //    MaxDelay is only checked by writeDigit: there is no timer thread, so
+    //    when the input stops, the last digits stay buffered until flush() or
+    //    the destructor. Call flush() when the input goes quiet if they must
+    //    show up sooner.
+    struct FlushPolicy {
+        bool Buffered = false;
+        std::size_t MaxBytes = 16 * 1024;
+        std::chrono::milliseconds MaxDelay{50};
+    };
+
+    class Terminal final : public IStream , public OStream{
         private:
+            static constexpr std::size_t BufferSize = 64 * 1024;
+
             std::ostream & out = std::cout ;
+            FlushPolicy policy;
+            std::array<char, BufferSize> buffer;
+            std::size_t used = 0;
+            std::chrono::nanoseconds oldest{0};     // when the first buffered digit was written
         public:
         Terminal()=default;
+        explicit Terminal(const FlushPolicy & flushPolicy, std::ostream & stream = std::cout);
+
+        Terminal(const Terminal&) = delete;
+        Terminal& operator=(const Terminal&) = delete;
+
             void writeDigit(int) override;
+            void flush();
+
+        ~Terminal();
     };
-}
\ No newline at end of file
+}
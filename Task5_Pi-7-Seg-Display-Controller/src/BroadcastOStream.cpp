@@ -0,0 +1,82 @@
+#include "BroadcastOStream.hpp"
+#include "clock.hpp"
+
+namespace HardwareIO
+{
+    void BroadcastOStream::drain(Sink & sink)
+    {
+        Item item;
+        while (sink.queue.pop(item)) {
+            try {
+                sink.output->writeDigit(item.digit);
+            }
+            catch (const std::exception&) {
+                sink.errors.fetch_add(1, std::memory_order_release);
+                continue;
+            }
+            // Same clock as the stamp in writeDigit, even if it was swapped since this worker started
+            long long latency = MCAL::ActiveClock().Now().count() - item.queuedNs;
+            if (latency > sink.maxLatencyNs.load(std::memory_order_relaxed)) {
+                sink.maxLatencyNs.store(latency, std::memory_order_relaxed);
+            }
+            sink.written.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    std::size_t BroadcastOStream::addSink(std::shared_ptr<OStream> sink, const SinkConfig & config)
+    {
+        if (!sink) throw std::invalid_argument("Broadcast sink must not be null");
+
+        sinks.push_back(std::make_unique<Sink>(std::move(sink), config));
+        Sink & added = *sinks.back();
+        if (added.name.empty()) added.name = "sink" + std::to_string(sinks.size() - 1);
+        added.worker = std::thread(&BroadcastOStream::drain, std::ref(added));
+        return sinks.size() - 1;
+    }
+
+    void BroadcastOStream::writeDigit(int digit)
+    {
+        // Validation is each sink's business; a rejected digit shows up in its Errors
+        Item item{digit, MCAL::ActiveClock().Now().count()};
+        for (auto & sink : sinks) {
+            sink->queue.push(item);
+        }
+        broadcast.fetch_add(1, std::memory_order_release);
+    }
+
+    void BroadcastOStream::flush()
+    {
+        for (auto & sink : sinks) {
+            // Written + failed + dropped catches up with what was broadcast once the queue is empty
+            unsigned long long target = broadcast.load(std::memory_order_acquire);
+            while (sink->written.load(std::memory_order_acquire) + sink->errors.load(std::memory_order_acquire) +
+                   sink->queue.stats().Dropped < target) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    SinkStats BroadcastOStream::stats(std::size_t index) const
+    {
+        const Sink & sink = *sinks.at(index);
+        SinkStats result;
+        result.Name = sink.name;
+        result.Queue = sink.queue.stats();
+        result.Written = sink.written.load(std::memory_order_acquire);
+        result.Errors = sink.errors.load(std::memory_order_acquire);
+        unsigned long long settled = result.Written + result.Errors + result.Queue.Dropped;
+        unsigned long long sent = broadcast.load(std::memory_order_acquire);
+        result.Lag = sent > settled ? sent - settled : 0;
+        result.MaxLatency = std::chrono::nanoseconds(sink.maxLatencyNs.load(std::memory_order_relaxed));
+        return result;
+    }
+
+    BroadcastOStream::~BroadcastOStream()
+    {
+        for (auto & sink : sinks) sink->queue.close();
+        for (auto & sink : sinks) {
+            if (sink->worker.joinable()) sink->worker.join();
+        }
+    }
+
+} // namespace HardwareIO
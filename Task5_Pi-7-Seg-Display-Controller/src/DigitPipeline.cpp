@@ -0,0 +1,112 @@
+#include "DigitPipeline.hpp"
+#include "clock.hpp"
+#include <exception>
+#include <thread>
+
+namespace HardwareIO
+{
+    void DigitPipeline::LatencyCounter::add(long long ns)
+    {
+        count.fetch_add(1, std::memory_order_relaxed);
+        sumNs.fetch_add(ns, std::memory_order_relaxed);
+        if (ns > maxNs.load(std::memory_order_relaxed)) maxNs.store(ns, std::memory_order_relaxed);
+    }
+
+    StageLatency DigitPipeline::LatencyCounter::snapshot() const
+    {
+        StageLatency result;
+        result.Count = count.load();
+        if (result.Count > 0) result.Avg = std::chrono::nanoseconds(sumNs.load() / static_cast<long long>(result.Count));
+        result.Max = std::chrono::nanoseconds(maxNs.load());
+        return result;
+    }
+
+    DigitPipeline::DigitPipeline(IStream & in, OStream & out, const PipelineConfig & config)
+        : input(in), output(out), queue(config.QueueCapacity, config.Policy)
+    {
+    }
+
+    void DigitPipeline::readerStage()
+    {
+        MCAL::Clock & clock = MCAL::ActiveClock();
+        while (!stopping.load(std::memory_order_relaxed)) {
+            auto start = clock.Now();
+            DigitResult result = input.tryReadDigit();
+            auto now = clock.Now();
+            readLatency.add((now - start).count());
+
+            if (result) {
+                queue.push(Item{result.value, now.count()});
+            } else if (result.error == InputError::EndOfInput) {
+                break;
+            } else {
+                inputErrors.fetch_add(1, std::memory_order_relaxed);
+                if (OnInputError) OnInputError(result.error);
+            }
+
+            if (KeepReading && !KeepReading()) break;
+        }
+        queue.close();
+    }
+
+    void DigitPipeline::writerStage()
+    {
+        MCAL::Clock & clock = MCAL::ActiveClock();
+        Item item;
+        while (queue.pop(item)) {
+            auto start = clock.Now();
+            waitLatency.add(start.count() - item.queuedNs);
+            try {
+                output.writeDigit(item.digit);
+            }
+            catch (const std::exception& e) {
+                // Keep draining: one bad write must not wedge the reader on a full queue
+                if (OnWriteError) OnWriteError(e);
+                continue;
+            }
+            writeLatency.add((clock.Now() - start).count());
+            if (OnWritten) OnWritten(item.digit);
+        }
+    }
+
+    void DigitPipeline::run()
+    {
+        stopping = false;
+        std::exception_ptr writerError;
+        std::thread writer([this, &writerError] {
+            try {
+                writerStage();
+            }
+            catch (...) {
+                writerError = std::current_exception();
+                // A reader blocked on the full queue wakes up and stops
+                stopping = true;
+                queue.close();
+            }
+        });
+
+        try {
+            readerStage();
+        }
+        catch (...) {
+            // The writer drains what was queued and exits; never leave it joinable
+            queue.close();
+            writer.join();
+            throw;
+        }
+        writer.join();
+        if (writerError) std::rethrow_exception(writerError);
+    }
+
+    PipelineStats DigitPipeline::stats() const
+    {
+        PipelineStats result;
+        result.Queue = queue.stats();
+        result.Read = readLatency.snapshot();
+        result.QueueWait = waitLatency.snapshot();
+        result.Write = writeLatency.snapshot();
+        result.InputErrors = inputErrors.load();
+        return result;
+    }
+
+} // namespace HardwareIO
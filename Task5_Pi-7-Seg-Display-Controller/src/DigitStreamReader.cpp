@@ -0,0 +1,147 @@
+#include "DigitStreamReader.hpp"
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace HardwareIO
+{
+    static constexpr std::uint64_t HighBits = 0x8080808080808080ULL;
+    static constexpr std::uint64_t Zeros = 0x3030303030303030ULL;    // '0' in every byte
+    static constexpr std::uint64_t PastNine = 0x4646464646464646ULL; // 0x80 - ':'
+
+    // True when all 8 bytes are '0'..'9'. Each lane works on 7 bits with the
+    // top bit as a guard, so no borrow or carry crosses into the next byte.
+    static inline bool allDigits(std::uint64_t word)
+    {
+        std::uint64_t below = ~((word | HighBits) - Zeros) & HighBits;
+        std::uint64_t above = ((word & ~HighBits) + PastNine) & HighBits;
+        return ((below | above | (word & HighBits))) == 0;
+    }
+
+    DigitStreamReader::DigitStreamReader(const std::string & path)
+    {
+        if (path == "-") {
+            fd = STDIN_FILENO;
+        } else {
+            fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) throw std::runtime_error("Can't open " + path + " - " + strerror(errno));
+            ownsFd = true;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            void * region = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (region != MAP_FAILED) {
+                madvise(region, static_cast<std::size_t>(info.st_size), MADV_SEQUENTIAL);
+                mapped = static_cast<const unsigned char *>(region);
+                mappedSize = static_cast<std::size_t>(info.st_size);
+            }
+        }
+    }
+
+    DigitStreamReader::DigitStreamReader(int fileDescriptor) : fd(fileDescriptor) {}
+
+    DigitStreamReader::~DigitStreamReader()
+    {
+        if (mapped != nullptr) munmap(const_cast<unsigned char *>(mapped), mappedSize);
+        if (ownsFd) close(fd);
+    }
+
+    void DigitStreamReader::decode(const unsigned char * data, std::size_t size)
+    {
+        std::size_t out = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            if (allDigits(word)) {
+                word -= Zeros;
+                std::memcpy(values.data() + out, &word, sizeof(word));
+                out += 8;
+                continue;
+            }
+            for (std::size_t j = i; j < i + 8; j++) {
+                unsigned char c = data[j];
+                if (c >= '0' && c <= '9') values[out++] = static_cast<std::uint8_t>(c - '0');
+                else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') values[out++] = Invalid;
+            }
+        }
+        for (; i < size; i++) {
+            unsigned char c = data[i];
+            if (c >= '0' && c <= '9') values[out++] = static_cast<std::uint8_t>(c - '0');
+            else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') values[out++] = Invalid;
+        }
+        head = 0;
+        tail = out;
+    }
+
+    // Decode the next block; false at end of input
+    bool DigitStreamReader::refill()
+    {
+        while (head == tail && !endOfInput) {
+            if (mapped != nullptr) {
+                std::size_t size = mappedSize - mappedOffset;
+                if (size > BlockSize) size = BlockSize;
+                if (size == 0) {
+                    endOfInput = true;
+                    break;
+                }
+                decode(mapped + mappedOffset, size);
+                mappedOffset += size;
+            } else {
+                ssize_t got = read(fd, raw.data(), raw.size());
+                if (got < 0 && errno == EINTR) continue;
+                if (got <= 0) {
+                    endOfInput = true;
+                    break;
+                }
+                decode(raw.data(), static_cast<std::size_t>(got));
+            }
+        }
+        return head != tail;
+    }
+
+    bool DigitStreamReader::eof()
+    {
+        return !refill();
+    }
+
+    DigitResult DigitStreamReader::tryReadDigit() noexcept
+    {
+        if (!refill()) return {0, InputError::EndOfInput};
+        std::uint8_t value = values[head++];
+        if (value == Invalid) return {0, InputError::NotADigit};
+        return {value, InputError::None};
+    }
+
+    std::size_t DigitStreamReader::readDigits(std::uint8_t * out, std::size_t max, InputError * stoppedBy)
+    {
+        std::size_t copied = 0;
+        InputError stop = InputError::None;
+        while (copied < max) {
+            if (!refill()) {
+                stop = InputError::EndOfInput;
+                break;
+            }
+            std::size_t available = tail - head;
+            if (available > max - copied) available = max - copied;
+            const std::uint8_t * start = values.data() + head;
+            const void * bad = std::memchr(start, Invalid, available);
+            if (bad != nullptr) available = static_cast<std::size_t>(static_cast<const std::uint8_t *>(bad) - start);
+            std::memcpy(out + copied, start, available);
+            head += available;
+            copied += available;
+            if (bad != nullptr) {
+                stop = InputError::NotADigit;
+                break;
+            }
+        }
+        if (stoppedBy != nullptr) *stoppedBy = stop;
+        return copied;
+    }
+
+} // namespace HardwareIO
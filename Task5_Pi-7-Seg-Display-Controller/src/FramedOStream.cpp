@@ -0,0 +1,95 @@
+#include "FramedOStream.hpp"
+#include <stdexcept>
+
+namespace HardwareIO
+{
+    FramedOStream::FramedOStream(std::size_t digitCount) : digits(digitCount)
+    {
+        if (digits == 0 || digits > MaxFrameDigits)
+            throw std::invalid_argument("A frame holds 1 to 8 digits");
+    }
+
+    void FramedOStream::commit()
+    {
+        frames.publish();
+        // parked is set before the driver re-checks for a fresh frame, so
+        // either it sees this frame or we see it parked and wake it
+        if (parked.load()) {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            wake.notify_one();
+        }
+    }
+
+    void FramedOStream::wakeDriver()
+    {
+        // Same handshake as commit(), on a flag instead of the frame buffer
+        nudged = true;
+        if (parked.load()) {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            wake.notify_one();
+        }
+    }
+
+    bool FramedOStream::waitForFrame()
+    {
+        std::unique_lock<std::mutex> lock(parkMutex);
+        parked = true;
+        wake.wait(lock, [&] { return stopping.load() || frames.hasFresh() || nudged.load(); });
+        parked = false;
+        nudged = false;
+        return !stopping.load();
+    }
+
+    void FramedOStream::requestStop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+    }
+
+    void FramedOStream::writeDigit(int x)
+    {
+        Frame & frame = frames.back();
+        for (std::size_t i = 0; i + 1 < digits; i++) frame[i] = frame[i + 1];
+        frame[digits - 1] = digitGlyph(x);
+        commit();
+    }
+
+    void FramedOStream::setDigit(std::size_t position, SegmentMask mask)
+    {
+        if (position >= digits) return;
+        frames.back()[position] = mask;
+        commit();
+    }
+
+    void FramedOStream::setText(const char * text)
+    {
+        Frame & frame = frames.back();
+        frame.fill(BlankGlyph);
+        std::size_t position = 0;
+        for (; *text != '\0'; text++) {
+            if (*text == '.' && position > 0 && !(frame[position - 1] & SegDP)) {
+                frame[position - 1] |= SegDP;
+                continue;
+            }
+            if (position == digits) break;
+            frame[position++] = glyphFor(*text);
+        }
+        commit();
+    }
+
+    void FramedOStream::setFrame(const Frame & frame)
+    {
+        frames.back() = frame;
+        commit();
+    }
+
+    void FramedOStream::clear()
+    {
+        frames.back().fill(BlankGlyph);
+        commit();
+    }
+
+} // namespace HardwareIO
@@ -4,16 +4,34 @@
 
 namespace HardwareIO {
 
-    int IStream::readDigit() {
+    const char * describe(InputError error) {
+        switch (error) {
+            case InputError::None: return "No error.";
+            case InputError::NotADigit: return "Input is not a single digit between 0 and 9.";
+            case InputError::EndOfInput: return "End of input.";
+        }
+        return "Unknown input error.";
+    }
+
+    DigitResult IStream::tryReadDigit() noexcept {
         char inputChar;
         std::cout << "Enter a digit (0-9): ";
-        std::cin >> inputChar;
+        if (!(std::cin >> inputChar)) {
+            return {0, InputError::EndOfInput};
+        }
 
         if (inputChar >= '0' && inputChar <= '9') {
-        return static_cast<int>(inputChar - '0'); 
+        return {static_cast<int>(inputChar - '0'), InputError::None}; 
         } else {
-            throw std::invalid_argument("Input is not a single digit between 0 and 9.");
+            return {0, InputError::NotADigit};
         }
     }
 
-}
\ No newline at end of file
+    int IStream::readDigit() {
+        DigitResult result = tryReadDigit();
+        if (result.error == InputError::NotADigit) throw std::invalid_argument(describe(result.error));
+        if (result.error == InputError::EndOfInput) throw std::runtime_error(describe(result.error));
+        return result.value;
+    }
+
+}
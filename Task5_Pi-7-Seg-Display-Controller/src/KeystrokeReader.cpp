@@ -0,0 +1,150 @@
+#include "KeystrokeReader.hpp"
+#include "clock.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <poll.h>
+#include <pthread.h>
+
+namespace HardwareIO
+{
+    // Process-wide raw-mode state, shared with the signal handlers (which may
+    // only call async-signal-safe functions: tcsetattr, sigaction, raise)
+    static volatile sig_atomic_t rawFd = -1;
+    static struct termios cookedMode;
+    static struct termios rawMode;
+
+    static constexpr int RestoreSignals[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT, SIGTSTP, SIGCONT};
+    static struct sigaction previousActions[sizeof(RestoreSignals) / sizeof(RestoreSignals[0])];
+
+    static void restoreCooked() {
+        if (rawFd >= 0) tcsetattr(rawFd, TCSANOW, &cookedMode);
+    }
+
+    static void restoreAtExit() {
+        restoreCooked();
+        rawFd = -1;
+    }
+
+    static void onSignal(int signal) {
+        int saved = errno;
+        if (signal == SIGCONT) {
+            // Back in the foreground after Ctrl-Z
+            if (rawFd >= 0) tcsetattr(rawFd, TCSANOW, &rawMode);
+            errno = saved;
+            return;
+        }
+
+        restoreCooked();
+        struct sigaction defaultAction {};
+        defaultAction.sa_handler = SIG_DFL;
+        sigemptyset(&defaultAction.sa_mask);
+        sigaction(signal, &defaultAction, nullptr);
+        raise(signal);
+
+        // The signal is blocked while its own handler runs: unblock it so the
+        // default action (stop or terminate) happens here, not after return.
+        // raise() targets this thread, so only this thread's mask matters;
+        // sigprocmask is unspecified once the pipeline threads exist.
+        sigset_t pending;
+        sigemptyset(&pending);
+        sigaddset(&pending, signal);
+        pthread_sigmask(SIG_UNBLOCK, &pending, nullptr);
+
+        if (signal == SIGTSTP) {
+            // Reached once the process continues: re-arm the handler
+            struct sigaction action {};
+            action.sa_handler = onSignal;
+            sigemptyset(&action.sa_mask);
+            sigaction(SIGTSTP, &action, nullptr);
+        }
+        errno = saved;
+    }
+
+    KeystrokeReader::KeystrokeReader(int fileDescriptor) : fd(fileDescriptor)
+    {
+        if (!isatty(fd)) return;
+        if (rawFd >= 0) {
+            std::cerr << "Error: terminal is already in raw mode, keys need Enter" << std::endl;
+            return;
+        }
+        if (tcgetattr(fd, &cookedMode) < 0) return;
+
+        rawMode = cookedMode;
+        rawMode.c_lflag &= ~(ICANON | ECHO);
+        rawMode.c_cc[VMIN] = 1;
+        rawMode.c_cc[VTIME] = 0;
+
+        static bool atExitRegistered = false;
+        if (!atExitRegistered) atExitRegistered = std::atexit(restoreAtExit) == 0;
+
+        rawFd = fd;
+        struct sigaction action {};
+        action.sa_handler = onSignal;
+        sigemptyset(&action.sa_mask);
+        for (std::size_t i = 0; i < sizeof(RestoreSignals) / sizeof(RestoreSignals[0]); i++) {
+            sigaction(RestoreSignals[i], &action, &previousActions[i]);
+        }
+
+        if (tcsetattr(fd, TCSANOW, &rawMode) < 0) {
+            std::cerr << "Error: can't switch terminal to raw mode" << std::endl;
+            for (std::size_t i = 0; i < sizeof(RestoreSignals) / sizeof(RestoreSignals[0]); i++) {
+                sigaction(RestoreSignals[i], &previousActions[i], nullptr);
+            }
+            rawFd = -1;
+            return;
+        }
+        raw = true;
+    }
+
+    bool KeystrokeReader::readKey(Keystroke & key, std::chrono::milliseconds timeout)
+    {
+        struct pollfd request {fd, POLLIN, 0};
+        int ready;
+        do {
+            ready = poll(&request, 1, static_cast<int>(timeout.count()));
+        } while (ready < 0 && errno == EINTR);
+        if (ready <= 0) return false;
+
+        char byte;
+        ssize_t count;
+        do {
+            count = read(fd, &byte, 1);
+        } while (count < 0 && errno == EINTR);
+        if (count != 1) return false;
+
+        key.Key = byte;
+        key.Time = MCAL::ActiveClock().Now();
+        lastKey = key.Time;
+        return true;
+    }
+
+    DigitResult KeystrokeReader::tryReadDigit() noexcept
+    {
+        Keystroke key;
+        while (readKey(key)) {
+            switch (key.Key) {
+                case '\n': case '\r': case ' ': case '\t':
+                    continue;
+                case 'q': case 'Q': case 0x04:      // Ctrl-D
+                    return {0, InputError::EndOfInput};
+                default:
+                    if (key.Key >= '0' && key.Key <= '9') return {key.Key - '0', InputError::None};
+                    return {0, InputError::NotADigit};
+            }
+        }
+        return {0, InputError::EndOfInput};
+    }
+
+    KeystrokeReader::~KeystrokeReader()
+    {
+        if (!raw) return;
+        restoreCooked();
+        rawFd = -1;
+        for (std::size_t i = 0; i < sizeof(RestoreSignals) / sizeof(RestoreSignals[0]); i++) {
+            sigaction(RestoreSignals[i], &previousActions[i], nullptr);
+        }
+    }
+
+} // namespace HardwareIO
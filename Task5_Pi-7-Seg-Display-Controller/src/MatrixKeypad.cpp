@@ -0,0 +1,209 @@
+#include "MatrixKeypad.hpp"
+#include "clock.hpp"
+#include <ctime>
+#include <poll.h>
+#include <stdexcept>
+
+namespace HardwareIO
+{
+    static long long threadCpuNs()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return now.tv_sec * 1000000000LL + now.tv_nsec;
+    }
+
+    // True if key (row-major bit) completes a rectangle with three other keys
+    // in down: on a diode-less matrix it may only be their phantom
+    static bool completesRectangle(std::uint16_t down, int key)
+    {
+        const int row = key / 4, column = key % 4;
+        const unsigned rowKeys = (down >> (row * 4)) & 0xFu & ~(1u << column);    // the rest of key's row
+        for (int otherRow = 0; otherRow < 4; otherRow++) {
+            if (otherRow == row) continue;
+            unsigned otherKeys = (down >> (otherRow * 4)) & 0xFu;
+            if ((otherKeys & (1u << column)) && (otherKeys & rowKeys)) return true;
+        }
+        return false;
+    }
+
+    MatrixKeypad::MatrixKeypad(KeypadConfig cfg)
+        : config(std::move(cfg)), events(config.QueueCapacity, Backpressure::DropOldest)
+    {
+        if (config.ActiveScanHz == 0 || config.IdleScanHz == 0)
+            throw std::invalid_argument("Keypad scan rates must be positive");
+
+        rowPins.reserve(4);
+        for (int pin : config.RowPins) rowPins.emplace_back(pin, MCAL::GPIO::PinOUT, MCAL::GPIO::PinHigh);
+        columnPins.reserve(4);
+        for (int pin : config.ColumnPins) {
+            columnPins.emplace_back(pin, MCAL::GPIO::PinIN);
+            columnPins.back().SetPinEdge(MCAL::GPIO::EdgeFalling);
+        }
+    }
+
+    MatrixKeypad::~MatrixKeypad()
+    {
+        stop();
+    }
+
+    void MatrixKeypad::start()
+    {
+        if (scanner.joinable()) return;
+        // stop() closed the queue; no reader is inside readKey once it has seen the end
+        events.reopen();
+        stopping = false;
+        scanner = std::thread(&MatrixKeypad::scanLoop, this);
+    }
+
+    void MatrixKeypad::stop()
+    {
+        if (scanner.joinable()) {
+            stopping = true;
+            scanner.join();
+        }
+        events.close();
+    }
+
+    // Bit row * 4 + column set for every key that reads down
+    std::uint16_t MatrixKeypad::scanMatrix()
+    {
+        std::uint16_t down = 0;
+        for (int row = 0; row < 4; row++) {
+            std::uint32_t levels = 0xFu & ~(1u << row);
+            MCAL::GPIO::GPIO_WritePins(rowPins, levels, levels ^ rowLevels);
+            rowLevels = levels;
+
+            std::uint32_t columns = 0xF;
+            if (MCAL::GPIO::GPIO_Snapshot(columnPins, columns) < 0) continue;
+            down |= static_cast<std::uint16_t>((~columns & 0xFu) << (row * 4));
+        }
+        return down;
+    }
+
+    void MatrixKeypad::debounce(std::uint16_t raw, std::chrono::nanoseconds now)
+    {
+        std::uint16_t changed = raw ^ debounced;
+        std::uint16_t started = changed & ~pending;
+        pending = changed;
+        ghosted &= changed;
+
+        for (std::uint16_t bits = started; bits != 0; bits &= bits - 1) {
+            changedAt[__builtin_ctz(bits)] = now;
+        }
+
+        for (std::uint16_t bits = changed; bits != 0; bits &= bits - 1) {
+            int key = __builtin_ctz(bits);
+            if (now - changedAt[key] < config.Debounce) continue;
+
+            bool pressed = (raw >> key) & 1u;
+            if (pressed && config.SuppressGhosts && completesRectangle(raw, key)) {
+                if (!(ghosted & (1u << key))) {
+                    ghosts.fetch_add(1, std::memory_order_relaxed);
+                    ghosted |= static_cast<std::uint16_t>(1u << key);
+                }
+                continue;
+            }
+
+            debounced ^= static_cast<std::uint16_t>(1u << key);
+            pending &= static_cast<std::uint16_t>(~(1u << key));
+            if (pressed) presses.fetch_add(1, std::memory_order_relaxed);
+
+            KeyEvent event;
+            event.Key = config.Keymap[key];
+            event.Pressed = pressed;
+            event.FirstSeen = changedAt[key];
+            event.Reported = now;
+            events.push(event);
+        }
+    }
+
+    // Every row low, so a press anywhere pulls its column low, then sleep
+    // until a column edge or the idle scan is due
+    void MatrixKeypad::waitForEdge(std::chrono::nanoseconds timeout)
+    {
+        MCAL::GPIO::GPIO_WritePins(rowPins, 0, rowLevels);
+        rowLevels = 0;
+
+        std::array<struct pollfd, 4> fds{};
+        for (std::size_t i = 0; i < fds.size(); i++) {
+            fds[i].fd = columnPins[i].ValueFd();
+            fds[i].events = POLLPRI | POLLERR;
+        }
+        idle = true;
+        poll(fds.data(), fds.size(), static_cast<int>(timeout.count() / 1000000));
+        idle = false;
+    }
+
+    void MatrixKeypad::scanLoop()
+    {
+        MCAL::Clock & clock = MCAL::ActiveClock();
+        const std::chrono::nanoseconds activePeriod(1000000000LL / config.ActiveScanHz);
+        const std::chrono::nanoseconds idlePeriod(1000000000LL / config.IdleScanHz);
+
+        // A restarted keypad carries on from the previous run's totals
+        const auto started = clock.Now() - std::chrono::nanoseconds(runningNs.load());
+        const long long cpuStart = threadCpuNs() - cpuNs.load();
+        auto lastChange = clock.Now();
+
+        while (!stopping.load(std::memory_order_relaxed)) {
+            auto scanStart = clock.Now();
+            std::uint16_t raw = scanMatrix();
+            debounce(raw, scanStart);
+            scans.fetch_add(1, std::memory_order_relaxed);
+
+            if (raw != debounced || debounced != 0) lastChange = scanStart;
+            if (scanStart - lastChange < config.IdleAfter) {
+                auto elapsed = clock.Now() - scanStart;
+                if (elapsed < activePeriod) clock.SleepFor(activePeriod - elapsed);
+            } else {
+                waitForEdge(idlePeriod);
+            }
+
+            runningNs.store((clock.Now() - started).count(), std::memory_order_relaxed);
+            cpuNs.store(threadCpuNs() - cpuStart, std::memory_order_relaxed);
+        }
+    }
+
+    bool MatrixKeypad::readKey(KeyEvent & event)
+    {
+        if (!events.pop(event)) return false;
+
+        long long latency = (MCAL::ActiveClock().Now() - event.FirstSeen).count();
+        delivered.fetch_add(1, std::memory_order_relaxed);
+        latencySumNs.fetch_add(latency, std::memory_order_relaxed);
+        if (latency > latencyMaxNs.load(std::memory_order_relaxed)) latencyMaxNs.store(latency, std::memory_order_relaxed);
+        return true;
+    }
+
+    DigitResult MatrixKeypad::tryReadDigit() noexcept
+    {
+        KeyEvent event;
+        while (readKey(event)) {
+            if (!event.Pressed) continue;
+            if (event.Key >= '0' && event.Key <= '9') return {event.Key - '0', InputError::None};
+            return {0, InputError::NotADigit};
+        }
+        return {0, InputError::EndOfInput};
+    }
+
+    KeypadStats MatrixKeypad::stats() const
+    {
+        KeypadStats result;
+        result.Scans = scans.load();
+        result.Presses = presses.load();
+        result.Ghosts = ghosts.load();
+        result.Dropped = events.stats().Dropped;
+        long long running = runningNs.load();
+        if (running > 0) {
+            result.ScanHz = result.Scans * 1e9 / running;
+            result.CpuPercent = 100.0 * cpuNs.load() / running;
+        }
+        unsigned long long count = delivered.load();
+        if (count > 0) result.MeanLatency = std::chrono::nanoseconds(latencySumNs.load() / static_cast<long long>(count));
+        result.MaxLatency = std::chrono::nanoseconds(latencyMaxNs.load());
+        result.Idle = idle.load();
+        return result;
+    }
+
+} // namespace HardwareIO
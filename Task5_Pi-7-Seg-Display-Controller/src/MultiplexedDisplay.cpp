@@ -0,0 +1,210 @@
+#include "MultiplexedDisplay.hpp"
+#include "clock.hpp"
+#include <stdexcept>
+
+namespace HardwareIO
+{
+    MultiplexedDisplay::MultiplexedDisplay(MultiplexConfig cfg)
+        : FramedOStream(cfg.DigitPins.size()), config(std::move(cfg))
+    {
+        if (config.SegmentPins.size() < 7 || config.SegmentPins.size() > 8)
+            throw std::invalid_argument("MultiplexedDisplay needs 7 or 8 segment pins");
+        if (config.RefreshHz == 0)
+            throw std::invalid_argument("RefreshHz must be positive");
+
+        segmentBits = (1u << config.SegmentPins.size()) - 1;
+        for (auto & level : brightness) level.store(FullBrightness, std::memory_order_relaxed);
+        drivenLevels = config.SegmentActiveLow ? segmentBits : 0;
+
+        int segmentOff = config.SegmentActiveLow ? MCAL::GPIO::PinHigh : MCAL::GPIO::PinLow;
+        int digitOff = config.DigitActiveLow ? MCAL::GPIO::PinHigh : MCAL::GPIO::PinLow;
+        segmentPins.reserve(config.SegmentPins.size());
+        for (int pin : config.SegmentPins) segmentPins.emplace_back(pin, MCAL::GPIO::PinOUT, segmentOff);
+        digitPins.reserve(config.DigitPins.size());
+        for (int pin : config.DigitPins) digitPins.emplace_back(pin, MCAL::GPIO::PinOUT, digitOff);
+    }
+
+    MultiplexedDisplay::~MultiplexedDisplay()
+    {
+        stop();
+    }
+
+    void MultiplexedDisplay::brightnessChanged()
+    {
+        brightnessVersion.fetch_add(1, std::memory_order_release);
+        // Not commit(): publishing belongs to the single frame writer
+        wakeDriver();
+    }
+
+    void MultiplexedDisplay::setBrightness(std::uint8_t level)
+    {
+        for (auto & segment : brightness) segment.store(level, std::memory_order_relaxed);
+        brightnessChanged();
+    }
+
+    void MultiplexedDisplay::setDigitBrightness(std::size_t digit, std::uint8_t level)
+    {
+        if (digit >= digitCount()) return;
+        for (std::size_t segment = 0; segment < 8; segment++)
+            brightness[digit * 8 + segment].store(level, std::memory_order_relaxed);
+        brightnessChanged();
+    }
+
+    void MultiplexedDisplay::setSegmentBrightness(std::size_t digit, std::size_t segment, std::uint8_t level)
+    {
+        if (digit >= digitCount() || segment >= 8) return;
+        brightness[digit * 8 + segment].store(level, std::memory_order_relaxed);
+        brightnessChanged();
+    }
+
+    // Returns true when some lit segment needs modulation
+    bool MultiplexedDisplay::buildAllPlanes(const Frame & frame)
+    {
+        bool modulated = false;
+        for (std::size_t digit = 0; digit < digitCount(); digit++) {
+            SegmentLevels levels;
+            for (std::size_t segment = 0; segment < 8; segment++) {
+                levels[segment] = brightness[digit * 8 + segment].load(std::memory_order_relaxed);
+                if ((frame[digit] & segmentBits & (1u << segment)) && levels[segment] != FullBrightness) modulated = true;
+            }
+            planes[digit] = buildPlanes(frame[digit], levels);
+        }
+        return modulated;
+    }
+
+    void MultiplexedDisplay::start()
+    {
+        if (refresher.joinable()) return;
+        clearStop();
+        refresher = std::thread(&MultiplexedDisplay::refreshLoop, this);
+    }
+
+    void MultiplexedDisplay::stop()
+    {
+        if (!refresher.joinable()) return;
+        requestStop();
+        refresher.join();
+    }
+
+    RefreshStats MultiplexedDisplay::stats() const
+    {
+        RefreshStats result;
+        result.Slots = slots.load();
+        long long active = activeNs.load();
+        if (active > 0) result.AchievedHz = result.Slots * 1e9 / active;
+        if (result.Slots > 0) result.MeanJitter = std::chrono::nanoseconds(jitterSumNs.load() / static_cast<long long>(result.Slots));
+        result.MaxJitter = std::chrono::nanoseconds(jitterMaxNs.load());
+        result.Parked = isParked();
+        return result;
+    }
+
+    void MultiplexedDisplay::setDigitEnabled(std::size_t digit, bool enabled)
+    {
+        int level = (enabled != config.DigitActiveLow) ? MCAL::GPIO::PinHigh : MCAL::GPIO::PinLow;
+        digitPins[digit].SetPinVal(level);
+    }
+
+    // At most: one disable, the changed segment lines, one enable
+    void MultiplexedDisplay::driveSlot(std::size_t digit, SegmentMask mask)
+    {
+        std::uint32_t lit = mask & segmentBits;
+        if (enabledDigit >= 0 && (static_cast<std::size_t>(enabledDigit) != digit || lit == 0)) {
+            setDigitEnabled(static_cast<std::size_t>(enabledDigit), false);
+            enabledDigit = -1;
+        }
+        if (lit == 0) return;
+
+        std::uint32_t levels = config.SegmentActiveLow ? (~lit & segmentBits) : lit;
+        MCAL::GPIO::GPIO_WritePins(segmentPins, levels, levels ^ drivenLevels);
+        drivenLevels = levels;
+
+        if (enabledDigit < 0) {
+            setDigitEnabled(digit, true);
+            enabledDigit = static_cast<int>(digit);
+        }
+    }
+
+    void MultiplexedDisplay::refreshLoop()
+    {
+        std::optional<MCAL::RealTimeScope> realTime;
+        if (config.RealTime) realTime.emplace(*config.RealTime);
+
+        MCAL::Clock & clock = MCAL::ActiveClock();
+        const std::chrono::nanoseconds period(1000000000LL / config.RefreshHz);
+        const std::size_t count = digitCount();
+
+        // One brightness unit; the 8 planes of a slot last 1+2+...+128 = 255 units
+        const std::chrono::nanoseconds unit = period / 255;
+
+        Frame frame{};
+        bool modulated = false;
+        unsigned seenBrightness = brightnessVersion.load(std::memory_order_acquire) - 1;
+        std::size_t slot = 0;
+        auto deadline = clock.Now();
+        auto previousStart = deadline;
+        bool resumed = true;
+
+        while (!stopRequested()) {
+            bool fresh = frames.acquire();
+            unsigned currentBrightness = brightnessVersion.load(std::memory_order_acquire);
+            if (fresh || resumed || currentBrightness != seenBrightness) {
+                frame = frames.front();
+                seenBrightness = currentBrightness;
+                modulated = buildAllPlanes(frame);
+
+                std::size_t lit = 0, litDigit = 0;
+                for (std::size_t i = 0; i < count; i++) {
+                    if (frame[i] & segmentBits) {
+                        lit++;
+                        litDigit = i;
+                    }
+                }
+                if (lit == 0 || (lit == 1 && !modulated)) {
+                    // Nothing to multiplex: latch the single digit (or blank) and park
+                    driveSlot(litDigit, frame[litDigit]);
+                    waitForFrame();
+                    resumed = true;
+                    continue;
+                }
+            }
+
+            auto now = clock.Now();
+            if (resumed) {
+                deadline = now;
+                resumed = false;
+            } else {
+                activeNs += (now - previousStart).count();
+            }
+            previousStart = now;
+
+            long long late = (now - deadline).count();
+            if (late < 0) late = 0;
+            jitterSumNs += late;
+            if (late > jitterMaxNs.load(std::memory_order_relaxed)) jitterMaxNs = late;
+            slots++;
+
+            if (!modulated) {
+                driveSlot(slot, frame[slot]);
+            } else {
+                // Planes 7..1 on their own deadlines; plane 0 runs to the slot deadline
+                auto planeEnd = now;
+                for (std::size_t plane = BrightnessPlanes - 1; plane > 0; plane--) {
+                    driveSlot(slot, planes[slot][plane]);
+                    planeEnd += unit * (1 << plane);
+                    clock.SleepPrecise(planeEnd - clock.Now());
+                }
+                driveSlot(slot, planes[slot][0]);
+            }
+            slot = (slot + 1) % count;
+
+            deadline += period;
+            // Fell more than a slot behind: restart the schedule rather than burst
+            if (clock.Now() - deadline > period) deadline = clock.Now();
+            clock.SleepPrecise(deadline - clock.Now());
+        }
+
+        if (enabledDigit >= 0) setDigitEnabled(static_cast<std::size_t>(enabledDigit), false);
+        enabledDigit = -1;
+    }
+
+} // namespace HardwareIO
@@ -1,50 +1,26 @@
 #include "SevenSegment.hpp"
-#include "gpio.hpp"
 
 namespace HardwareIO
 {
-    void SevenSegment::init_map()
-    {
-        SevenSegment::representation = {
-            {0, {0, 0, 0, 0, 0, 0, 1}},
-            {1, {1, 0, 0, 1, 1, 1, 1}},
-            {2, {0, 0, 1, 0, 0, 1, 0}},
-            {3, {0, 0, 0, 0, 1, 1, 0}},
-            {4, {1, 0, 0, 1, 1, 0, 0}},
-            {5, {0, 1, 0, 0, 1, 0, 0}},
-            {6, {0, 1, 0, 0, 0, 0, 0}},
-            {7, {0, 0, 0, 1, 1, 1, 1}},
-            {8, {0, 0, 0, 0, 0, 0, 0}},
-            {9, {0, 0, 0, 0, 1, 0, 0}}};
-    }
-    SevenSegment::SevenSegment()
-    {
-        init_map();
-        arr.fill(0); // initialize segment states
-        this->Pins = std::move(MCAL::GPIO::GPIO_InitPins({
-            {SevenSegmentPins[0], MCAL::GPIO::PinHigh, MCAL::GPIO::PinOUT},
-            {SevenSegmentPins[1], MCAL::GPIO::PinHigh, MCAL::GPIO::PinOUT},
-            {SevenSegmentPins[2], MCAL::GPIO::PinHigh, MCAL::GPIO::PinOUT},
-            {SevenSegmentPins[3], MCAL::GPIO::PinHigh, MCAL::GPIO::PinOUT},
-            {SevenSegmentPins[4], MCAL::GPIO::PinHigh, MCAL::GPIO::PinOUT},
-            {SevenSegmentPins[5], MCAL::GPIO::PinHigh, MCAL::GPIO::PinOUT},
-            {SevenSegmentPins[6], MCAL::GPIO::PinHigh, MCAL::GPIO::PinOUT},
-        }));
-    }
+    // The stock board is compiled once here; other boards instantiate where used
+    template class BasicSevenSegment<DefaultBoard>;
+
+    // Common anode: blank drives every pin high, 8 drives every pin low
+    static_assert(SevenSegment::Levels[BlankGlyph] == 0x7F, "common anode blanks high");
+    static_assert(SevenSegment::Levels[0x7F] == 0x00, "common anode lights low");
 
-    void SevenSegment::writeDigit(int x)
+    namespace
     {
-        SevenSegment::arr = SevenSegment::representation[x];
-        for (int i = 0; i < 7; i++)
-        {
-            if (arr[i] == 0)
-            {
-                Pins[i].SetPinVal(MCAL::GPIO::PinLow);
-            }
-            else if(arr[i]==1){
-                Pins[i].SetPinVal(MCAL::GPIO::PinHigh);
-            }
-        }
+        // Scrambled common-cathode wiring with dp: checks the permutation
+        struct ScrambledCathodeBoard {
+            static constexpr std::array<int, 8> SegmentPins = {5, 3, 9, 2, 7, 4, 8, 6};
+            static constexpr Polarity Wiring = Polarity::CommonCathode;
+        };
+        // "1" lights b (pin 3) and c (pin 9): bits 1 and 7 of the ascending pin order 2,3,4,5,6,7,8,9
+        static_assert(BasicSevenSegment<ScrambledCathodeBoard>::Levels[digitGlyph(1)] == ((1u << 1) | (1u << 7)),
+                      "segments are permuted into pin order");
+        static_assert(BasicSevenSegment<ScrambledCathodeBoard>::Levels[SegDP] == (1u << 4),
+                      "dp follows the board map");
     }
 
 } // namespace name
@@ -0,0 +1,93 @@
+#include "ShiftRegisterDisplay.hpp"
+#include "clock.hpp"
+
+namespace HardwareIO
+{
+    enum { DataLine, ClockLine, LatchLine };
+
+    ShiftRegisterDisplay::ShiftRegisterDisplay(const ShiftRegisterConfig & cfg)
+        : FramedOStream(cfg.Digits), config(cfg)
+    {
+        pins = MCAL::GPIO::GPIO_InitPins({
+            {config.DataPin, MCAL::GPIO::PinLow, MCAL::GPIO::PinOUT},
+            {config.ClockPin, MCAL::GPIO::PinLow, MCAL::GPIO::PinOUT},
+            {config.LatchPin, MCAL::GPIO::PinLow, MCAL::GPIO::PinOUT},
+        });
+    }
+
+    ShiftRegisterDisplay::~ShiftRegisterDisplay()
+    {
+        stop();
+    }
+
+    // The last digit's register is the far end of the chain, so it goes
+    // first; within a register QH (dp) is shifted first and QA (a) last.
+    std::size_t ShiftRegisterDisplay::buildBitStream(const Frame & frame, std::uint8_t (&bits)[MaxBits]) const
+    {
+        std::size_t count = 0;
+        std::uint8_t invert = config.SegmentActiveLow ? 0xFF : 0x00;
+        for (std::size_t digit = digitCount(); digit-- > 0;) {
+            std::uint8_t levels = frame[digit] ^ invert;
+            for (int bit = 7; bit >= 0; bit--) bits[count++] = (levels >> bit) & 1u;
+        }
+        return count;
+    }
+
+    void ShiftRegisterDisplay::shiftOut(const std::uint8_t (&bits)[MaxBits], std::size_t count)
+    {
+        unsigned long long writes = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            if (bits[i] != dataLevel) {
+                dataLevel = bits[i];
+                pins[DataLine].SetPinVal(dataLevel);
+                writes++;
+            }
+            pins[ClockLine].SetPinVal(MCAL::GPIO::PinHigh);
+            pins[ClockLine].SetPinVal(MCAL::GPIO::PinLow);
+        }
+        pins[LatchLine].SetPinVal(MCAL::GPIO::PinHigh);
+        pins[LatchLine].SetPinVal(MCAL::GPIO::PinLow);
+        gpioWrites += writes + 2 * count + 2;
+    }
+
+    void ShiftRegisterDisplay::start()
+    {
+        if (driver.joinable()) return;
+        clearStop();
+        driver = std::thread(&ShiftRegisterDisplay::driveLoop, this);
+    }
+
+    void ShiftRegisterDisplay::stop()
+    {
+        if (!driver.joinable()) return;
+        requestStop();
+        driver.join();
+    }
+
+    ShiftRegisterStats ShiftRegisterDisplay::stats() const
+    {
+        ShiftRegisterStats result;
+        result.Frames = frameCount.load();
+        long long ns = shiftNs.load();
+        if (ns > 0) result.DigitsPerSecond = result.Frames * digitCount() * 1e9 / ns;
+        if (result.Frames > 0) result.GpioWritesPerFrame = static_cast<double>(gpioWrites.load()) / result.Frames;
+        return result;
+    }
+
+    void ShiftRegisterDisplay::driveLoop()
+    {
+        MCAL::Clock & clock = MCAL::ActiveClock();
+        std::uint8_t bits[MaxBits];
+
+        while (waitForFrame()) {
+            if (!frames.acquire()) continue;
+            std::size_t count = buildBitStream(frames.front(), bits);
+
+            auto start = clock.Now();
+            shiftOut(bits, count);
+            shiftNs += (clock.Now() - start).count();
+            frameCount++;
+        }
+    }
+
+} // namespace HardwareIO
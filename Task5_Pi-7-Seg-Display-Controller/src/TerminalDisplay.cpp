@@ -0,0 +1,140 @@
+#include "TerminalDisplay.hpp"
+#include "clock.hpp"
+#include <charconv>
+#include <stdexcept>
+
+namespace HardwareIO
+{
+    TerminalDisplay::TerminalDisplay(std::size_t digits, unsigned fps, std::ostream & stream)
+        : FramedOStream(digits), out(stream), maxFps(fps)
+    {
+        if (maxFps == 0) throw std::invalid_argument("Frame rate must be positive");
+        for (auto & row : shown) row.fill(' ');
+        pending.reserve(Rows * (MaxColumns + 16));
+    }
+
+    // "ESC [ n <command>" without going through std::to_string
+    static void appendCsi(std::string & text, std::size_t n, const char * command)
+    {
+        char digits[20];
+        char * end = std::to_chars(digits, digits + sizeof(digits), n).ptr;
+        text += "\x1b[";
+        text.append(digits, static_cast<std::size_t>(end - digits));
+        text += command;
+    }
+
+    TerminalDisplay::~TerminalDisplay()
+    {
+        stop();
+    }
+
+    TerminalDisplay::Cells TerminalDisplay::layout(const Frame & frame) const
+    {
+        Cells cells;
+        for (auto & row : cells) row.fill(' ');
+        for (std::size_t digit = 0; digit < digitCount(); digit++) {
+            SegmentMask m = frame[digit];
+            std::size_t c = digit * CellsPerDigit;
+            if (m & SegA) cells[0][c + 1] = '_';
+            if (m & SegF) cells[1][c] = '|';
+            if (m & SegG) cells[1][c + 1] = '_';
+            if (m & SegB) cells[1][c + 2] = '|';
+            if (m & SegE) cells[2][c] = '|';
+            if (m & SegD) cells[2][c + 1] = '_';
+            if (m & SegC) cells[2][c + 2] = '|';
+            if (m & SegDP) cells[2][c + 3] = '.';
+        }
+        return cells;
+    }
+
+    void TerminalDisplay::render()
+    {
+        frames.acquire();
+        const Cells next = layout(frames.front());
+        const std::size_t columns = digitCount() * CellsPerDigit;
+        pending.clear();
+
+        if (!drawn) {
+            for (std::size_t row = 0; row < Rows; row++) {
+                pending.append(next[row].data(), columns);
+                pending += '\n';
+            }
+            drawn = true;
+            fullFrameBytes = pending.size();
+        } else {
+            // Cursor rests at column 1 of the line below the art
+            for (std::size_t row = 0; row < Rows; row++) {
+                std::size_t column = 0;
+                while (column < columns) {
+                    if (next[row][column] == shown[row][column]) {
+                        column++;
+                        continue;
+                    }
+                    std::size_t end = column;
+                    while (end < columns && next[row][end] != shown[row][end]) end++;
+
+                    appendCsi(pending, Rows - row, "A");
+                    appendCsi(pending, column + 1, "G");
+                    pending.append(next[row].data() + column, end - column);
+                    appendCsi(pending, Rows - row, "B\r");
+                    column = end;
+                }
+            }
+
+            // Many scattered changes (a whole row of digits scrolling) cost
+            // more in cursor moves than redrawing the art in full
+            if (pending.size() > Rows * (columns + 1) + 5) {
+                pending.clear();
+                appendCsi(pending, Rows, "A\r");
+                for (std::size_t row = 0; row < Rows; row++) {
+                    pending.append(next[row].data(), columns);
+                    pending += '\n';
+                }
+            }
+        }
+
+        shown = next;
+        if (!pending.empty()) {
+            out.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+            out.flush();
+            emittedBytes += pending.size();
+        }
+        renderedFrames++;
+    }
+
+    double TerminalDisplay::bytesPerUpdate() const
+    {
+        unsigned long long frames = frameCount();
+        if (frames < 2) return 0;
+        return static_cast<double>(byteCount() - fullFrameBytes.load(std::memory_order_relaxed)) / (frames - 1);
+    }
+
+    void TerminalDisplay::start()
+    {
+        if (renderer.joinable()) return;
+        clearStop();
+        renderer = std::thread(&TerminalDisplay::renderLoop, this);
+    }
+
+    void TerminalDisplay::stop()
+    {
+        if (!renderer.joinable()) return;
+        requestStop();
+        renderer.join();
+    }
+
+    void TerminalDisplay::renderLoop()
+    {
+        MCAL::Clock & clock = MCAL::ActiveClock();
+        const std::chrono::nanoseconds minInterval(1000000000LL / maxFps);
+
+        render();
+        while (waitForFrame()) {
+            auto start = clock.Now();
+            render();
+            // Frames published meanwhile collapse into the next render
+            clock.SleepFor(minInterval - (clock.Now() - start));
+        }
+    }
+
+} // namespace HardwareIO
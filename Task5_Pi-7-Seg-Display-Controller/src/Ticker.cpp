@@ -0,0 +1,107 @@
+#include "Ticker.hpp"
+#include "clock.hpp"
+#include <cstdio>
+#include <stdexcept>
+
+namespace HardwareIO
+{
+    Ticker::Ticker(std::size_t digitCount) : digits(digitCount)
+    {
+        if (digits == 0 || digits > MaxFrameDigits)
+            throw std::invalid_argument("A ticker frame holds 1 to 8 digits");
+    }
+
+    void Ticker::load(const char * text, TickerEffect effect)
+    {
+        // Text -> glyphs, with '.' folded into the previous glyph's decimal point
+        std::vector<SegmentMask> glyphs;
+        for (; *text != '\0'; text++) {
+            if (*text == '.' && !glyphs.empty() && !(glyphs.back() & SegDP)) glyphs.back() |= SegDP;
+            else glyphs.push_back(glyphFor(*text));
+        }
+
+        frames.clear();
+        if (effect == TickerEffect::Blink) {
+            Frame shown{};
+            for (std::size_t i = 0; i < digits && i < glyphs.size(); i++) shown[i] = glyphs[i];
+            frames.push_back(shown);
+            frames.push_back(Frame{});
+            return;
+        }
+
+        // Scroll: the message slides across a blank window from right to left
+        std::size_t steps = glyphs.size() + digits;
+        frames.reserve(steps);
+        for (std::size_t step = 0; step < steps; step++) {
+            Frame window{};
+            for (std::size_t i = 0; i < digits; i++) {
+                std::size_t source = step + i;      // index into [blanks, glyphs]
+                if (source >= digits && source - digits < glyphs.size()) window[i] = glyphs[source - digits];
+            }
+            frames.push_back(window);
+        }
+    }
+
+    void Ticker::load(long long number, TickerEffect effect)
+    {
+        char text[24];
+        std::snprintf(text, sizeof(text), "%lld", number);
+        load(text, effect);
+    }
+
+    TickerPlayer::TickerPlayer(unsigned fps) : framesPerSecond(fps)
+    {
+        if (framesPerSecond == 0) throw std::invalid_argument("Frame rate must be positive");
+    }
+
+    TickerPlayer::~TickerPlayer()
+    {
+        stop();
+    }
+
+    void TickerPlayer::add(const Ticker & ticker, FramedOStream & display)
+    {
+        tracks.push_back({&ticker, &display, 0});
+    }
+
+    void TickerPlayer::tick()
+    {
+        for (auto & track : tracks) {
+            std::size_t count = track.ticker->frameCount();
+            if (count == 0) continue;
+            if (track.position >= count) track.position = 0;
+            track.display->setFrame(track.ticker->frame(track.position));
+            track.position++;
+        }
+        ticks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TickerPlayer::start()
+    {
+        if (player.joinable()) return;
+        stopping = false;
+        player = std::thread(&TickerPlayer::playLoop, this);
+    }
+
+    void TickerPlayer::stop()
+    {
+        if (!player.joinable()) return;
+        stopping = true;
+        player.join();
+    }
+
+    void TickerPlayer::playLoop()
+    {
+        MCAL::Clock & clock = MCAL::ActiveClock();
+        const std::chrono::nanoseconds period(1000000000LL / framesPerSecond);
+        auto deadline = clock.Now();
+
+        while (!stopping.load(std::memory_order_relaxed)) {
+            tick();
+            deadline += period;
+            if (clock.Now() - deadline > period) deadline = clock.Now();
+            clock.SleepFor(deadline - clock.Now());
+        }
+    }
+
+} // namespace HardwareIO
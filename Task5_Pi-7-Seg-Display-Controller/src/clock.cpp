@@ -0,0 +1,42 @@
+#include "clock.hpp"
+#include <thread>
+#include "precision_delay.hpp"
+
+namespace MCAL {
+
+    std::chrono::nanoseconds RealClock::Now() {
+        return std::chrono::steady_clock::now().time_since_epoch();
+    }
+
+    void RealClock::SleepFor(std::chrono::nanoseconds duration) {
+        std::this_thread::sleep_for(duration);
+    }
+
+    void RealClock::SleepPrecise(std::chrono::nanoseconds duration) {
+        PrecisionDelay::Instance().SleepFor(duration);
+    }
+
+    std::chrono::nanoseconds VirtualClock::Now() {
+        return std::chrono::nanoseconds(nowNs.load(std::memory_order_acquire));
+    }
+
+    void VirtualClock::SleepFor(std::chrono::nanoseconds duration) {
+        Advance(duration);
+    }
+
+    void VirtualClock::Advance(std::chrono::nanoseconds duration) {
+        if (duration.count() > 0) nowNs.fetch_add(duration.count(), std::memory_order_acq_rel);
+    }
+
+    static RealClock realClock;
+    static std::atomic<Clock *> activeClock{&realClock};
+
+    Clock & ActiveClock() {
+        return *activeClock.load(std::memory_order_acquire);
+    }
+
+    void SetActiveClock(Clock * clock) {
+        activeClock.store(clock != nullptr ? clock : &realClock, std::memory_order_release);
+    }
+
+}
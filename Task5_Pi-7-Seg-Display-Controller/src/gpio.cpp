@@ -1,35 +1,37 @@
 #include "gpio.hpp"
+#include "clock.hpp"
+#include "gpio_trace.hpp"
 #include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
-#include <thread>
 #include <chrono>
 #include <cerrno>
+#include <cstdio>
 
 namespace MCAL {
     namespace GPIO {
 
         // ---------- Private helpers ----------
         int GpioPin::writeToFile(const std::string& path, const std::string& value) {
-            fd = open(path.c_str(), O_WRONLY);
-            if (fd < 0) {
+            int fileFd = open(path.c_str(), O_WRONLY);
+            if (fileFd < 0) {
                 std::cerr << "Error: Can't open " << path << " - " << strerror(errno) << std::endl;
                 return -1;
             }
-            auto numBytes = write(fd, value.c_str(), value.length());
-            close(fd);
+            auto numBytes = write(fileFd, value.c_str(), value.length());
+            close(fileFd);
             return numBytes;
         }
 
         std::string GpioPin::readFromFile(const std::string& path) {
-            fd = open(path.c_str(), O_RDONLY);
-            if (fd < 0) {
+            int fileFd = open(path.c_str(), O_RDONLY);
+            if (fileFd < 0) {
                 std::cerr << "Error: Can't open " << path << " - " << strerror(errno) << std::endl;
                 return "";
             }
             char buffer[64];
-            auto numBytes = read(fd, buffer, sizeof(buffer) - 1);
-            close(fd);
+            auto numBytes = read(fileFd, buffer, sizeof(buffer) - 1);
+            close(fileFd);
 
             if (numBytes > 0) {
                 buffer[numBytes] = '\0';
@@ -38,34 +40,80 @@ namespace MCAL {
             return "";
         }
 
+        // One acquire load when no recorder is installed
+        static inline void trace(TraceOp op, int pin, int value) noexcept {
+            if (TraceRecorder * recorder = GPIO_TraceRecorder()) recorder->Record(op, pin, value);
+        }
+
+        static std::string & sysfsRoot() {
+            static std::string root = "/sys/class/gpio";
+            return root;
+        }
+
+        void GPIO_SetSysfsRoot(const std::string & root) { sysfsRoot() = root; }
+        const std::string & GPIO_SysfsRoot() { return sysfsRoot(); }
+
+        // The value attribute stays valid across direction changes, so it is
+        // opened once and then accessed with pread/pwrite at offset 0. Threads
+        // racing on the first access each open it; one descriptor is published
+        // and the losers close theirs.
+        int GpioPin::openValueFd() noexcept {
+            int current = fd.load(std::memory_order_acquire);
+            if (current >= 0) return current;
+            if (PinNumber == -1) {
+                // Default-constructed or moved-from: callers report errno
+                errno = EBADF;
+                return -1;
+            }
+
+            char path[128];
+            std::snprintf(path, sizeof(path), "%s/gpio%d/value", sysfsRoot().c_str(), GPIO_BASE + PinNumber);
+            int opened = open(path, O_RDWR | O_CLOEXEC);
+            if (opened < 0) return -1;
+
+            if (!fd.compare_exchange_strong(current, opened, std::memory_order_acq_rel)) {
+                close(opened);
+                return current;
+            }
+            return opened;
+        }
+
+        void GpioPin::closeValueFd() noexcept {
+            int current = fd.exchange(-1, std::memory_order_acq_rel);
+            if (current >= 0) close(current);
+        }
+
         void GpioPin::ActivePin() {
             int absolutePin = GPIO_BASE + PinNumber;
             std::string pinStr = std::to_string(absolutePin);
             std::cout << "Exporting GPIO " << absolutePin << " (Pin " << PinNumber << ")" << std::endl;
-            writeToFile(ExportPATH, pinStr);
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            writeToFile(sysfsRoot() + "/export", pinStr);
+            trace(TraceOp::Export, PinNumber, 0);
+            MCAL::ActiveClock().SleepFor(std::chrono::milliseconds(100));
         }
 
         void GpioPin::DeactivePin() {
+            closeValueFd();
             int absolutePin = GPIO_BASE + PinNumber;
             std::string pinStr = std::to_string(absolutePin);
             std::cout << "Unexporting GPIO " << absolutePin << std::endl;
-            writeToFile(UnexportPATH, pinStr);
+            writeToFile(sysfsRoot() + "/unexport", pinStr);
+            trace(TraceOp::Unexport, PinNumber, 0);
         }
 
         // ---------- Constructors ----------
-        GpioPin::GpioPin() : PinNumber(-1), PinDirection(PinOUT), PinState(PinLow), fd(-1) {}
+        GpioPin::GpioPin() : fd(-1), PinNumber(-1), PinDirection(PinOUT), PinState(PinLow) {}
 
-        GpioPin::GpioPin(int Num) : PinNumber(Num), PinDirection(PinOUT), PinState(PinLow), fd(-1) {
+        GpioPin::GpioPin(int Num) : fd(-1), PinNumber(Num), PinDirection(PinOUT), PinState(PinLow) {
             ActivePin();
         }
 
-        GpioPin::GpioPin(int Num, int dir) : PinNumber(Num), PinDirection(dir), PinState(PinLow), fd(-1) {
+        GpioPin::GpioPin(int Num, int dir) : fd(-1), PinNumber(Num), PinDirection(dir), PinState(PinLow) {
             ActivePin();
             SetPinDir(PinDirection);
         }
 
-        GpioPin::GpioPin(int Num, int dir, int state) : PinNumber(Num), PinDirection(dir), PinState(state), fd(-1) {
+        GpioPin::GpioPin(int Num, int dir, int state) : fd(-1), PinNumber(Num), PinDirection(dir), PinState(state) {
             ActivePin();
             SetPinDir(PinDirection);
             SetPinVal(PinState);
@@ -73,7 +121,8 @@ namespace MCAL {
 
         // ---------- Move constructor / assignment ----------
         GpioPin::GpioPin(GpioPin && ref) noexcept
-            : fd(ref.fd), PinNumber(ref.PinNumber), PinDirection(ref.PinDirection), PinState(ref.PinState)
+            : fd(ref.fd.exchange(-1)), PinNumber(ref.PinNumber),
+              PinDirection(ref.PinDirection.load()), PinState(ref.PinState.load())
         {
             ref.PinNumber = -1; // prevent deactivation in moved-from
         }
@@ -81,10 +130,10 @@ namespace MCAL {
         GpioPin & GpioPin::operator=(GpioPin && ref) noexcept {
             if(this != &ref) {
                 if(PinNumber != -1) DeactivePin();
-                fd = ref.fd;
+                fd.store(ref.fd.exchange(-1));
                 PinNumber = ref.PinNumber;
-                PinDirection = ref.PinDirection;
-                PinState = ref.PinState;
+                PinDirection.store(ref.PinDirection.load());
+                PinState.store(ref.PinState.load());
                 ref.PinNumber = -1;
             }
             return *this;
@@ -94,34 +143,74 @@ namespace MCAL {
         void GpioPin::SetPinDir(int dir) {
             PinDirection = dir;
             int absolutePin = GPIO_BASE + PinNumber;
-            std::string path = "/sys/class/gpio/gpio" + std::to_string(absolutePin) + "/direction";
+            std::string path = sysfsRoot() + "/gpio" + std::to_string(absolutePin) + "/direction";
 
-            if(PinDirection == PinIN) writeToFile(path, "in");
-            else if(PinDirection == PinOUT) writeToFile(path, "out");
-            else std::cout << "Invalid pin Direction\n";
+            if(dir == PinIN) writeToFile(path, "in");
+            else if(dir == PinOUT) writeToFile(path, "out");
+            else {
+                std::cout << "Invalid pin Direction\n";
+                return;
+            }
+            trace(TraceOp::Direction, PinNumber, dir);
         }
 
-        void GpioPin::SetPinVal(int val) {
-            PinState = val;
+        void GpioPin::SetPinEdge(int edge) {
+            static const char * const Edges[] = {"none", "rising", "falling", "both"};
+            if(edge < EdgeNone || edge > EdgeBoth) {
+                std::cout << "Invalid pin Edge\n";
+                return;
+            }
             int absolutePin = GPIO_BASE + PinNumber;
-            std::string path = "/sys/class/gpio/gpio" + std::to_string(absolutePin) + "/value";
+            writeToFile(sysfsRoot() + "/gpio" + std::to_string(absolutePin) + "/edge", Edges[edge]);
+            trace(TraceOp::Edge, PinNumber, edge);
+        }
 
-            if(val == PinLow) writeToFile(path, "0");
-            else if(val == PinHigh) writeToFile(path, "1");
-            else std::cout << "Invalid pin Value\n";
+        void GpioPin::SetPinVal(int val) {
+            if(val != PinLow && val != PinHigh) {
+                std::cout << "Invalid pin Value\n";
+                return;
+            }
+            PinState.store(val, std::memory_order_relaxed);
+            int valueFd = openValueFd();
+            if (valueFd < 0) {
+                int error = errno;
+                std::cerr << "Error: Can't open value of GPIO " << GPIO_BASE + PinNumber << " - " << strerror(error) << std::endl;
+                return;
+            }
+            const char level = static_cast<char>('0' + val);
+            pwrite(valueFd, &level, 1, 0);
+            trace(TraceOp::Write, PinNumber, val);
         }
 
         void GpioPin::Toggle_Pin() {
             SetPinVal(PinHigh);
-            sleep(3);
+            MCAL::ActiveClock().SleepFor(std::chrono::seconds(3));
             SetPinVal(PinLow);
-            sleep(3);
+            MCAL::ActiveClock().SleepFor(std::chrono::seconds(3));
         }
 
         int GpioPin::GetPinValue() {
-            int absolutePin = GPIO_BASE + PinNumber;
-            std::string PinValue = readFromFile("/sys/class/gpio/gpio" + std::to_string(absolutePin) + "/value");
-            return std::stoi(PinValue);
+            int value = -1;
+            if (GetPinValue(value) < 0) {
+                std::cerr << "Error: Can't read GPIO " << GPIO_BASE + PinNumber << std::endl;
+            }
+            return value;
+        }
+
+        int GpioPin::GetPinValue(int & value) noexcept {
+            int valueFd = openValueFd();
+            if (valueFd < 0) return -errno;
+
+            char buffer[4];
+            auto numBytes = pread(valueFd, buffer, sizeof(buffer), 0);
+            if (numBytes <= 0) return numBytes < 0 ? -errno : -ENODATA;
+
+            // "0\n" or "1\n": anything but those two digits is a malformed read
+            unsigned digit = static_cast<unsigned char>(buffer[0]) - static_cast<unsigned>('0');
+            int invalid = static_cast<int>(digit > 1u);
+            value = (value & -invalid) | (static_cast<int>(digit) & (invalid - 1));
+            if (!invalid) trace(TraceOp::Read, PinNumber, value);
+            return -EINVAL * invalid;
         }
 
         GpioPin::~GpioPin() {
@@ -145,5 +234,30 @@ namespace MCAL {
             return pins;
         }
 
+        // ---------- Bulk read ----------
+        int GPIO_Snapshot(std::vector<GpioPin> & pins, std::uint32_t & mask) noexcept {
+            mask = 0;
+            if (pins.size() > 32) return -E2BIG;
+            std::uint32_t bits = 0;
+            int status = 0;
+            for(std::size_t i = 0; i < pins.size() && status == 0; i++) {
+                int value = 0;
+                status = pins[i].GetPinValue(value);
+                bits |= static_cast<std::uint32_t>(value) << i;
+            }
+            mask = bits;
+            return status;
+        }
+
+        // ---------- Bulk write ----------
+        void GPIO_WritePins(std::vector<GpioPin> & pins, std::uint32_t levels, std::uint32_t changed) {
+            if (pins.size() < 32) changed &= (1u << pins.size()) - 1;
+            while (changed != 0) {
+                int i = __builtin_ctz(changed);
+                pins[i].SetPinVal(static_cast<int>((levels >> i) & 1u));
+                changed &= changed - 1;
+            }
+        }
+
     } // namespace GPIO
 } // namespace MCAL
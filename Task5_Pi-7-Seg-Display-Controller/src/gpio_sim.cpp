@@ -0,0 +1,54 @@
+#include "gpio_sim.hpp"
+#include "gpio.hpp"
+#include <stdexcept>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace MCAL {
+    namespace GPIO {
+
+        static void createFile(const std::string & path, const char * content) {
+            int fileFd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fileFd < 0) throw std::runtime_error("Can't create " + path);
+            auto written = write(fileFd, content, std::char_traits<char>::length(content));
+            close(fileFd);
+            if (written < 0) throw std::runtime_error("Can't write " + path);
+        }
+
+        SysfsSimulator::SysfsSimulator(int firstPin, int pinCount)
+            : previousRoot(GPIO_SysfsRoot()), firstPin(firstPin), pinCount(pinCount)
+        {
+            char pattern[] = "/tmp/gpio-sim-XXXXXX";
+            if (mkdtemp(pattern) == nullptr) throw std::runtime_error("Can't create simulator directory");
+            root = pattern;
+
+            createFile(root + "/export", "");
+            createFile(root + "/unexport", "");
+            for (int pin = firstPin; pin < firstPin + pinCount; pin++) {
+                std::string dir = root + "/gpio" + std::to_string(GPIO_BASE + pin);
+                mkdir(dir.c_str(), 0755);
+                createFile(dir + "/direction", "in\n");
+                createFile(dir + "/value", "0\n");
+                createFile(dir + "/edge", "none\n");
+            }
+            GPIO_SetSysfsRoot(root);
+        }
+
+        SysfsSimulator::~SysfsSimulator() {
+            GPIO_SetSysfsRoot(previousRoot);
+            for (int pin = firstPin; pin < firstPin + pinCount; pin++) {
+                std::string dir = root + "/gpio" + std::to_string(GPIO_BASE + pin);
+                unlink((dir + "/direction").c_str());
+                unlink((dir + "/value").c_str());
+                unlink((dir + "/edge").c_str());
+                rmdir(dir.c_str());
+            }
+            unlink((root + "/export").c_str());
+            unlink((root + "/unexport").c_str());
+            rmdir(root.c_str());
+        }
+
+    }
+}
@@ -0,0 +1,210 @@
+#include "gpio_trace.hpp"
+#include "gpio.hpp"
+#include "clock.hpp"
+#include <cstring>
+#include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace MCAL {
+    namespace GPIO {
+
+        static constexpr char TraceMagic[8] = {'G', 'P', 'I', 'O', 'T', 'R', 'C', '1'};
+        static constexpr std::uint32_t TraceVersion = 1;
+        static constexpr std::uint64_t TimeMask = (std::uint64_t{1} << 48) - 1;
+        static constexpr int MaxTracePin = 1023;
+
+        struct TraceHeader {
+            char Magic[8];
+            std::uint32_t Version;
+            std::uint32_t RecordSize;
+            std::uint64_t Capacity;
+            std::atomic<std::uint64_t> Count;   // events ever recorded
+            char Reserved[32];
+        };
+        static_assert(sizeof(TraceHeader) == 64, "trace header is 64 bytes");
+        static_assert(sizeof(std::atomic<std::uint64_t>) == 8 && std::atomic<std::uint64_t>::is_always_lock_free,
+                      "trace records are stored as lock-free 64-bit words");
+
+        static std::uint64_t encode(std::uint64_t timeNs, TraceOp op, int pin, int value) {
+            return ((timeNs & TimeMask) << 16) |
+                   (static_cast<std::uint64_t>(op) & 0xF) << 12 |
+                   (static_cast<std::uint64_t>(value) & 0x3) << 10 |
+                   (static_cast<std::uint64_t>(pin) & 0x3FF);
+        }
+
+        static TraceEvent decode(std::uint64_t word) {
+            TraceEvent event;
+            event.Time = std::chrono::nanoseconds(word >> 16);
+            event.Op = static_cast<TraceOp>((word >> 12) & 0xF);
+            event.Value = static_cast<int>((word >> 10) & 0x3);
+            event.Pin = static_cast<int>(word & 0x3FF);
+            return event;
+        }
+
+        // ---------- Recorder ----------
+        TraceRecorder::TraceRecorder(const std::string & path, std::size_t capacity)
+            : capacity(capacity)
+        {
+            if (capacity == 0) throw std::runtime_error("Trace capacity must be positive");
+
+            int fileFd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fileFd < 0) throw std::runtime_error("Can't create " + path + " - " + strerror(errno));
+
+            mappedSize = sizeof(TraceHeader) + capacity * sizeof(std::uint64_t);
+            if (ftruncate(fileFd, static_cast<off_t>(mappedSize)) < 0) {
+                close(fileFd);
+                throw std::runtime_error("Can't size " + path + " - " + strerror(errno));
+            }
+            void * mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileFd, 0);
+            close(fileFd);
+            if (mapping == MAP_FAILED) throw std::runtime_error("Can't map " + path + " - " + strerror(errno));
+
+            // The file is zero-filled, so every record starts out as TraceOp::None
+            header = new (mapping) TraceHeader{};
+            std::memcpy(header->Magic, TraceMagic, sizeof(TraceMagic));
+            header->Version = TraceVersion;
+            header->RecordSize = sizeof(std::uint64_t);
+            header->Capacity = capacity;
+            records = reinterpret_cast<std::atomic<std::uint64_t> *>(static_cast<char *>(mapping) + sizeof(TraceHeader));
+            start = MCAL::ActiveClock().Now();
+        }
+
+        void TraceRecorder::Record(TraceOp op, int pin, int value) noexcept {
+            if (pin < 0 || pin > MaxTracePin) return;
+            // A clock swapped after the recorder was created can run behind it
+            long long elapsed = (MCAL::ActiveClock().Now() - start).count();
+            std::uint64_t timeNs = elapsed > 0 ? static_cast<std::uint64_t>(elapsed) : 0;
+            std::uint64_t slot = header->Count.fetch_add(1, std::memory_order_relaxed) % capacity;
+            records[slot].store(encode(timeNs, op, pin, value), std::memory_order_relaxed);
+        }
+
+        std::uint64_t TraceRecorder::EventCount() const noexcept {
+            return header->Count.load(std::memory_order_relaxed);
+        }
+
+        TraceRecorder::~TraceRecorder() {
+            if (header == nullptr) return;
+            if (GPIO_TraceRecorder() == this) GPIO_SetTraceRecorder(nullptr);
+            msync(header, mappedSize, MS_SYNC);
+            munmap(header, mappedSize);
+        }
+
+        static std::atomic<TraceRecorder *> activeRecorder{nullptr};
+
+        void GPIO_SetTraceRecorder(TraceRecorder * recorder) {
+            activeRecorder.store(recorder, std::memory_order_release);
+        }
+
+        TraceRecorder * GPIO_TraceRecorder() {
+            return activeRecorder.load(std::memory_order_acquire);
+        }
+
+        // ---------- Loading ----------
+        std::vector<TraceEvent> GPIO_LoadTrace(const std::string & path) {
+            int fileFd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fileFd < 0) throw std::runtime_error("Can't open " + path + " - " + strerror(errno));
+
+            TraceHeader header;
+            std::vector<std::uint64_t> words;
+            bool valid = pread(fileFd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                         std::memcmp(header.Magic, TraceMagic, sizeof(TraceMagic)) == 0 &&
+                         header.Version == TraceVersion && header.RecordSize == sizeof(std::uint64_t) &&
+                         header.Capacity > 0;
+            if (valid) {
+                words.resize(header.Capacity);
+                std::size_t bytes = words.size() * sizeof(std::uint64_t);
+                valid = pread(fileFd, words.data(), bytes, sizeof(header)) == static_cast<ssize_t>(bytes);
+            }
+            close(fileFd);
+            if (!valid) throw std::runtime_error(path + " is not a GPIO trace");
+
+            // Oldest first: after a wrap the ring starts at the next slot to be overwritten
+            std::uint64_t count = header.Count.load();
+            std::uint64_t stored = count < header.Capacity ? count : header.Capacity;
+            std::uint64_t first = count < header.Capacity ? 0 : count % header.Capacity;
+
+            std::vector<TraceEvent> events;
+            events.reserve(stored);
+            for (std::uint64_t i = 0; i < stored; i++) {
+                TraceEvent event = decode(words[(first + i) % header.Capacity]);
+                if (event.Op != TraceOp::None) events.push_back(event);
+            }
+            return events;
+        }
+
+        // ---------- Replay ----------
+        namespace {
+            // Puts the caller's clock back however the replay ends
+            struct ClockRestore {
+                MCAL::Clock * previous;
+                ~ClockRestore() { MCAL::SetActiveClock(previous); }
+            };
+        }
+
+        ReplayStats GPIO_ReplayTrace(const std::vector<TraceEvent> & events, ReplayTiming timing) {
+            ReplayStats stats;
+            std::map<int, std::unique_ptr<GpioPin>> pins;
+
+            MCAL::VirtualClock virtualClock;
+            ClockRestore restore{&MCAL::ActiveClock()};
+            if (timing == ReplayTiming::AsFastAsPossible) MCAL::SetActiveClock(&virtualClock);
+            MCAL::Clock & clock = MCAL::ActiveClock();
+
+            auto pinFor = [&](int number) -> GpioPin & {
+                auto & pin = pins[number];
+                if (!pin) pin = std::make_unique<GpioPin>(number);
+                return *pin;
+            };
+
+            const auto wallStart = std::chrono::steady_clock::now();
+            const auto start = clock.Now();
+            const auto origin = events.empty() ? std::chrono::nanoseconds(0) : events.front().Time;
+            for (const TraceEvent & event : events) {
+                if (timing == ReplayTiming::Original) {
+                    // Absolute deadlines, so time spent inside an operation
+                    // (such as the export settle delay) is not added twice
+                    auto due = start + (event.Time - origin);
+                    auto now = clock.Now();
+                    if (due > now) clock.SleepPrecise(due - now);
+                    else if (now - due > stats.MaxLag) stats.MaxLag = now - due;
+                }
+
+                switch (event.Op) {
+                    case TraceOp::Export:
+                        pinFor(event.Pin);
+                        break;
+                    case TraceOp::Unexport:
+                        pins.erase(event.Pin);
+                        break;
+                    case TraceOp::Direction:
+                        pinFor(event.Pin).SetPinDir(event.Value);
+                        break;
+                    case TraceOp::Edge:
+                        pinFor(event.Pin).SetPinEdge(event.Value);
+                        break;
+                    case TraceOp::Write:
+                        pinFor(event.Pin).SetPinVal(event.Value);
+                        break;
+                    case TraceOp::Read: {
+                        int value = -1;
+                        if (pinFor(event.Pin).GetPinValue(value) < 0 || value != event.Value) stats.ReadMismatches++;
+                        break;
+                    }
+                    case TraceOp::None:
+                        break;
+                }
+                stats.Events++;
+            }
+            pins.clear();
+
+            stats.Elapsed = std::chrono::steady_clock::now() - wallStart;
+            return stats;
+        }
+
+    }
+}
@@ -0,0 +1,145 @@
+#include "perf_counters.hpp"
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace MCAL {
+
+    namespace {
+
+        struct EventSpec {
+            std::uint32_t Type;
+            std::uint64_t Config;
+        };
+
+        constexpr EventSpec EventSpecs[PerfEventCount] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+        };
+
+        int openEvent(const EventSpec & spec, bool excludeKernel) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = spec.Type;
+            attr.config = spec.Config;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = excludeKernel;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        }
+
+    }
+
+    const char * PerfEventName(PerfEvent event) {
+        switch (event) {
+            case PerfEvent::Cycles: return "cycles";
+            case PerfEvent::Instructions: return "instructions";
+            case PerfEvent::CacheMisses: return "cache-misses";
+            case PerfEvent::BranchMisses: return "branch-misses";
+            case PerfEvent::ContextSwitches: return "context-switches";
+        }
+        return "unknown";
+    }
+
+    PerfCounters::PerfCounters() {
+        fds.fill(-1);
+
+        // Kernel time if perf_event_paranoid allows it, user space only otherwise
+        kernelIncluded = true;
+        for (std::size_t i = 0; i < PerfEventCount; i++) {
+            fds[i] = openEvent(EventSpecs[i], false);
+            // A user-space-only context switch counter never counts anything
+            if (fds[i] >= 0 || static_cast<PerfEvent>(i) == PerfEvent::ContextSwitches) continue;
+            fds[i] = openEvent(EventSpecs[i], true);
+            if (fds[i] >= 0) kernelIncluded = false;
+        }
+        bool anyOpen = false;
+        for (int fd : fds) anyOpen = anyOpen || fd >= 0;
+        kernelIncluded = kernelIncluded && anyOpen;
+    }
+
+    PerfCounters::~PerfCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    bool PerfCounters::HardwareAvailable() const {
+        for (PerfEvent event : {PerfEvent::Cycles, PerfEvent::Instructions, PerfEvent::CacheMisses, PerfEvent::BranchMisses}) {
+            if (fds[static_cast<std::size_t>(event)] >= 0) return true;
+        }
+        return false;
+    }
+
+    bool PerfCounters::Available(PerfEvent event) const {
+        return event == PerfEvent::ContextSwitches || fds[static_cast<std::size_t>(event)] >= 0;
+    }
+
+    static long long processContextSwitches() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_nvcsw + usage.ru_nivcsw;
+    }
+
+    void PerfCounters::Start() {
+        switchesAtStart = processContextSwitches();
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    PerfReading PerfCounters::Stop(std::uint64_t operations) {
+        for (int fd : fds) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+
+        PerfReading reading;
+        reading.Operations = operations;
+        for (std::size_t i = 0; i < PerfEventCount; i++) {
+            if (fds[i] < 0) continue;
+            std::uint64_t values[3];     // value, time enabled, time running
+            if (read(fds[i], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values))) continue;
+            if (values[2] == 0) continue;   // never scheduled onto the PMU
+            reading.Totals[i] = static_cast<double>(values[0]) * values[1] / values[2];
+            reading.Valid[i] = true;
+        }
+
+        const std::size_t switches = static_cast<std::size_t>(PerfEvent::ContextSwitches);
+        if (!reading.Valid[switches]) {
+            reading.Totals[switches] = static_cast<double>(processContextSwitches() - switchesAtStart);
+            reading.Valid[switches] = true;
+        }
+        return reading;
+    }
+
+    std::ostream & operator<<(std::ostream & out, const PerfReading & reading) {
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::defaultfloat << std::setprecision(4);
+        for (std::size_t i = 0; i < PerfEventCount; i++) {
+            PerfEvent event = static_cast<PerfEvent>(i);
+            if (i > 0) out << "  ";
+            out << PerfEventName(event) << ' ';
+            if (reading.Has(event)) out << reading.PerOperation(event);
+            else out << "n/a";
+        }
+        out << " /op";
+        out.flags(flags);
+        out.precision(precision);
+        return out;
+    }
+
+}
@@ -0,0 +1,65 @@
+#include "precision_delay.hpp"
+#include <algorithm>
+#include <vector>
+#include <cerrno>
+#include <ctime>
+
+namespace MCAL {
+
+    // Bounds for the calibrated slack: always spin a little, never spin long
+    static constexpr std::chrono::nanoseconds MinSlack = std::chrono::microseconds(5);
+    static constexpr std::chrono::nanoseconds MaxSlack = std::chrono::milliseconds(2);
+    static constexpr std::chrono::nanoseconds CalibrationSleep = std::chrono::microseconds(50);
+
+    static timespec toTimespec(std::chrono::nanoseconds duration) {
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(duration.count() / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(duration.count() % 1000000000LL);
+        return ts;
+    }
+
+    std::chrono::nanoseconds PrecisionDelay::Now() {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+        return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+    }
+
+    PrecisionDelay & PrecisionDelay::Instance() {
+        static PrecisionDelay instance = [] {
+            PrecisionDelay delay;
+            delay.Calibrate();
+            return delay;
+        }();
+        return instance;
+    }
+
+    void PrecisionDelay::Calibrate(int samples) {
+        if (samples <= 0) samples = 1;
+        std::vector<std::chrono::nanoseconds> oversleep(static_cast<std::size_t>(samples));
+        const timespec request = toTimespec(CalibrationSleep);
+
+        for (auto & sample : oversleep) {
+            auto start = Now();
+            clock_nanosleep(CLOCK_MONOTONIC, 0, &request, nullptr);
+            sample = Now() - start - CalibrationSleep;
+        }
+
+        std::sort(oversleep.begin(), oversleep.end());
+        auto p99 = oversleep[static_cast<std::size_t>(samples - 1) * 99 / 100];
+        slack = std::min(std::max(p99, MinSlack), MaxSlack);
+    }
+
+    void PrecisionDelay::SleepFor(std::chrono::nanoseconds duration) const {
+        SleepUntil(Now() + duration);
+    }
+
+    void PrecisionDelay::SleepUntil(std::chrono::nanoseconds deadline) const {
+        auto remaining = deadline - Now();
+        if (remaining > slack) {
+            timespec request = toTimespec(remaining - slack);
+            while (clock_nanosleep(CLOCK_MONOTONIC, 0, &request, &request) == EINTR) {}
+        }
+        while (Now() < deadline) {}
+    }
+
+}
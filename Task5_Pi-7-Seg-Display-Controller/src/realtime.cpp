@@ -0,0 +1,91 @@
+#include "realtime.hpp"
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <pthread.h>
+#include <alloca.h>
+#include <sys/mman.h>
+
+namespace MCAL {
+
+    // Touch the stack the loop will use so it never page-faults later
+    __attribute__((noinline)) static void prefaultStack(std::size_t bytes) {
+        auto * stack = static_cast<unsigned char *>(alloca(bytes));
+        std::memset(stack, 0, bytes);
+        asm volatile("" : : "r"(stack) : "memory");
+    }
+
+    RealTimeScope::RealTimeScope(const RealTimeConfig & config) {
+        pthread_t self = pthread_self();
+        pthread_getschedparam(self, &previousPolicy, &previousParam);
+        CPU_ZERO(&previousAffinity);
+        pthread_getaffinity_np(self, sizeof(previousAffinity), &previousAffinity);
+
+        if (config.LockMemory) {
+            if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) memoryLocked = true;
+            else std::cerr << "Warning: mlockall failed - " << strerror(errno) << std::endl;
+        }
+        if (config.PrefaultStack > 0) prefaultStack(config.PrefaultStack);
+
+        if (config.Cpu >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(config.Cpu, &cpus);
+            int status = pthread_setaffinity_np(self, sizeof(cpus), &cpus);
+            if (status == 0) affinityApplied = true;
+            else std::cerr << "Warning: can't pin to CPU " << config.Cpu << " - " << strerror(status) << std::endl;
+        }
+
+        sched_param param{};
+        param.sched_priority = config.Priority;
+        int status = pthread_setschedparam(self, SCHED_FIFO, &param);
+        if (status == 0) schedulingApplied = true;
+        else std::cerr << "Warning: SCHED_FIFO unavailable - " << strerror(status) << std::endl;
+    }
+
+    RealTimeScope::~RealTimeScope() {
+        pthread_t self = pthread_self();
+        if (schedulingApplied) pthread_setschedparam(self, previousPolicy, &previousParam);
+        if (affinityApplied) pthread_setaffinity_np(self, sizeof(previousAffinity), &previousAffinity);
+        if (memoryLocked) munlockall();
+    }
+
+    static long long toNs(const timespec & ts) {
+        return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    }
+
+    WakeupLatency MeasureWakeupLatency(std::chrono::microseconds period, int samples) {
+        WakeupLatency result;
+        if (samples <= 0) return result;
+
+        std::vector<long long> late(static_cast<std::size_t>(samples));
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+        for (auto & sample : late) {
+            long long next = toNs(deadline) + std::chrono::duration_cast<std::chrono::nanoseconds>(period).count();
+            deadline.tv_sec = static_cast<time_t>(next / 1000000000LL);
+            deadline.tv_nsec = static_cast<long>(next % 1000000000LL);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {}
+
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            sample = toNs(now) - next;
+        }
+
+        std::sort(late.begin(), late.end());
+        long long sum = 0;
+        for (auto sample : late) sum += sample;
+
+        result.Samples = samples;
+        result.Min = std::chrono::nanoseconds(late.front());
+        result.Max = std::chrono::nanoseconds(late.back());
+        result.Avg = std::chrono::nanoseconds(sum / samples);
+        result.P99 = std::chrono::nanoseconds(late[static_cast<std::size_t>(samples - 1) * 99 / 100]);
+        return result;
+    }
+
+}
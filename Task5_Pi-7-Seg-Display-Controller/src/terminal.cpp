@@ -1,8 +1,45 @@
 #include "terminal.hpp"
+#include "clock.hpp"
+#include <charconv>
 
 namespace HardwareIO{
 
+    Terminal::Terminal(const FlushPolicy & flushPolicy, std::ostream & stream) : out(stream), policy(flushPolicy) {
+        if (policy.MaxBytes == 0 || policy.MaxBytes > BufferSize) policy.MaxBytes = BufferSize;
+    }
+
+    Terminal::~Terminal() {
+        flush();
+    }
+
     void Terminal::writeDigit(int x) {
-        out <<  x << std::endl;
+        if (!policy.Buffered) {
+            out <<  x << std::endl;
+            return;
+        }
+
+        // Longest line is "-2147483648\n"
+        if (BufferSize - used < 12) flush();
+        auto now = MCAL::ActiveClock().Now();
+        if (used == 0) oldest = now;
+
+        char * line = buffer.data() + used;
+        if (x >= 0 && x <= 9) {
+            *line++ = static_cast<char>('0' + x);
+        } else {
+            line = std::to_chars(line, buffer.data() + BufferSize, x).ptr;
+        }
+        *line++ = '\n';
+        used = static_cast<std::size_t>(line - buffer.data());
+
+        if (used >= policy.MaxBytes || now - oldest >= policy.MaxDelay) flush();
+    }
+
+    void Terminal::flush() {
+        if (used > 0) {
+            out.write(buffer.data(), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+        out.flush();
     }
-}
\ No newline at end of file
+}